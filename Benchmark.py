@@ -0,0 +1,253 @@
+#!/usr/bin/env python3
+
+import argparse
+import json
+import statistics
+import subprocess
+import tempfile
+import time
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Callable, Union
+
+
+@dataclass
+class BenchCase:
+    name: str
+    mode: str  # inline | file
+    payload: Union[str, Callable[[], str]]
+    tags: set[str] = field(default_factory=set)
+    args: list[str] = field(default_factory=list)
+    runs: int = 5
+    timeout: float = 60.0
+    precompile: bool = False  # file mode only: write the script's .cvc before timing
+    needs: list[str] = field(default_factory=list)  # CLI flags the binary must know, skipped otherwise
+
+
+@dataclass
+class BenchResult:
+    ok: bool
+    best: float
+    median: float
+    size: int
+    reason: str = ""
+
+
+def run_once(cmd, timeout: float, cwd: str) -> tuple[bool, float, str]:
+    started = time.perf_counter()
+    try:
+        proc = subprocess.run(cmd, capture_output=True, text=True, timeout=timeout, cwd=cwd)
+    except subprocess.TimeoutExpired:
+        return False, time.perf_counter() - started, f"timeout after {timeout}s"
+    elapsed = time.perf_counter() - started
+    if proc.returncode != 0:
+        return False, elapsed, f"exit={proc.returncode}, stdout={proc.stdout.strip()[:200]!r}"
+    return True, elapsed, ""
+
+
+def run_case(binary: str, case: BenchCase, runs: int) -> BenchResult:
+    payload = case.payload() if callable(case.payload) else case.payload
+    cwd = str(Path(binary).parent)
+    with tempfile.TemporaryDirectory(prefix="canvas-bench-") as td:
+        if case.mode == "file":
+            p = Path(td) / "bench.cv"
+            p.write_text(payload, encoding="utf-8")
+            cmd = [binary, *case.args, "-f", str(p)]
+            if case.precompile:
+                ok, _, reason = run_once([binary, "--precompile", "-f", str(p)], case.timeout, cwd)
+                if not ok:
+                    return BenchResult(False, 0.0, 0.0, len(payload), reason)
+        else:
+            cmd = [binary, *case.args, payload]
+        times = []
+        for _ in range(max(1, runs)):
+            ok, elapsed, reason = run_once(cmd, case.timeout, cwd)
+            if not ok:
+                return BenchResult(False, 0.0, 0.0, len(payload), reason)
+            times.append(elapsed)
+    return BenchResult(True, min(times), statistics.median(times), len(payload))
+
+
+_supported: dict[tuple[str, str], bool] = {}
+
+
+def supports(binary: str, flag: str) -> bool:
+    """Whether a binary knows a CLI flag. Older builds (--baseline) take unknown flags for code and fail"""
+    key = (binary, flag)
+    if key not in _supported:
+        probes = {
+            "--engine": [binary, "--engine", "interpreter", "nil"],
+        }
+        ok, _, _ = run_once(probes[flag], 10.0, str(Path(binary).parent))
+        _supported[key] = ok
+    return _supported[key]
+
+
+# --- generators ---
+
+def nested_call(depth: int) -> str:
+    return "[+ 1 " * depth + "1" + "]" * depth
+
+
+def parse_nested(depth: int, count: int) -> Callable[[], str]:
+    # Bodies of functions that are never called are parsed but not evaluated
+    def _gen():
+        return "".join(f"[let f{i} [fn [x] {nested_call(depth)}]]\n" for i in range(count))
+    return _gen
+
+
+def parse_flat(count: int) -> Callable[[], str]:
+    def _gen():
+        body = " ".join(f"[+ {i} 'item {i}' [nth [1 2 3] 0]]" for i in range(count))
+        return f"[let f [fn [x] [{body}]]]\n"
+    return _gen
+
+
+def parse_commented(lines: int) -> Callable[[], str]:
+    def _gen():
+        out = ["[let f [fn [x] [\n"]
+        for i in range(lines):
+            out.append(f"\t[let v{i} 'it\\'s line {i}\\n'] # comment with [brackets] and 'quotes'\n")
+        out.append("]]]\n")
+        return "".join(out)
+    return _gen
+
+
+def json_store(count: int, copies: int) -> Callable[[], str]:
+    # A store parsed from JSON, then copied with 'cc' and only read through the copies
+    def _gen():
+        body = json.dumps({f"u{i}": {"id": i, "name": f"user{i}", "tags": [i, i + 1]} for i in range(count)})
+        return (f"[import 'json']\n[let data [json:parse '{body}']]\n"
+                "[let pick [fn [s] [s 'u7']]]\n[let id [fn [u] [u 'id']]]\n[let n 0]\n"
+                f"[for [~i [0 {copies}]] [mut n [+ n [id [pick [cc data]]]]]]\n[print n]\n")
+    return _gen
+
+
+def build_cases() -> list[BenchCase]:
+    cases: list[BenchCase] = []
+
+    # Reference: process start and core setup only
+    cases += [
+        BenchCase("startup:nil", "inline", "nil", {"startup"}),
+    ]
+
+    # Parser throughput
+    cases += [
+        BenchCase("parse:flat", "file", parse_flat(20000), {"parse"}),
+        BenchCase("parse:commented", "file", parse_commented(20000), {"parse"}),
+        BenchCase("parse:nested-16", "file", parse_nested(16, 2000), {"parse"}),
+        BenchCase("parse:nested-128", "file", parse_nested(128, 250), {"parse"}),
+        BenchCase("parse:nested-1024", "file", parse_nested(1024, 16), {"parse"}),
+    ]
+
+    # Cold start of a large script, parsed from source or loaded from its precompiled tree
+    cold = parse_nested(16, 2000)
+    cases += [
+        BenchCase("cold:source", "file", cold, {"cold"}),
+        BenchCase("cold:cvc", "file", cold, {"cold"}, precompile=True),
+    ]
+
+    # Interpreter hot paths
+    cases += [
+        BenchCase("eval:literals", "inline",
+                  "[[let s 0] [for [~i [0 100000]] [mut s [+ s 1.5 2.5]] 'literal' nil] [s]]", {"eval"}),
+        BenchCase("call:builtin", "inline",
+                  "[[for [~i [0 100000]] [+ 1 2]] [+ 1 2]]", {"call"}),
+        BenchCase("call:user-fn", "inline",
+                  "[[let add [fn [a b] [+ a b]]] [for [~i [0 100000]] [add 1 2]] [add 1 2]]", {"call"}),
+        # Safe execution prefix, with a body that succeeds and one that always fails
+        BenchCase("try:ok", "inline",
+                  "[[let l [1 2 3]] [for [~i [0 1000000]] ?[nth l 1]] 0]", {"try"}, runs=3),
+        BenchCase("try:error", "inline",
+                  "[[let l [1 2 3]] [for [~i [0 1000000]] ?[nth l 5]] 0]", {"try"}, runs=3),
+        # Copies ('cc') of a list big enough to share chunks, then reading a copy through
+        BenchCase("list:cc", "inline",
+                  "[[let l [0 0]] [for [~i [0 20000]] [>> [+ i 0] l]] [let n 0] [for [~i [0 300]] [mut n [+ n [length [cc l]]]]] n]", {"list"}),
+        BenchCase("list:cc-read", "inline",
+                  "[[let l [0 0]] [for [~i [0 20000]] [>> [+ i 0] l]] [let c [cc l]] [let s 0] [for [~i [0 20000]] [mut s [+ s [nth c i]]]] s]", {"list"}),
+        # The same 100k member store parsed alone, then copied 20 times on top of that
+        BenchCase("store:json-parse", "file", json_store(100000, 0), {"store"}, runs=3),
+        BenchCase("store:json-cc", "file", json_store(100000, 20), {"store"}, runs=3),
+    ]
+
+    # Loop heavy scripts on both engines
+    loops = [
+        ("loop:for", "[[let s 0] [for [~i [0 200000]] [mut s [+ s i]]] s]"),
+        ("loop:while", "[[let i 0] [while [< i 100000] [mut i [+ i 1]]] i]"),
+        ("loop:fib", "[[let fib [fn [n] [if [< n 2] n [+ [fib [- n 1]] [fib [- n 2]]]]]] [fib 20]]"),
+        ("loop:nested-scopes", "[[let f [fn [a b] [for [~i [0 300]] [for [~j [0 300]] [+ a b i j]]]]] [f 1 2]]"),
+        # Tight loops: per iteration overhead, with and without a binding in the iteration's scope
+        ("loop:empty-for", "[[for [~i [0 500000]] i] 0]"),
+        ("loop:binding-for", "[[let s 0] [for [~i [0 200000]] [let j i] [mut s [+ s j]]] s]"),
+    ]
+    for engine in ("interpreter", "vm"):
+        cases += [
+            BenchCase(f"{name}:{engine}", "inline", payload, {"loop", engine}, ["--engine", engine],
+                      needs=["--engine"])
+            for name, payload in loops
+        ]
+
+    return cases
+
+
+def describe(result: BenchResult, startup: float) -> str:
+    if not result.ok:
+        return f"FAILURE ({result.reason})"
+    text = f"best {result.best * 1000:9.2f} ms | median {result.median * 1000:9.2f} ms"
+    work = result.best - startup
+    if result.size > 1024 and work > 0:
+        text += f" | {result.size / work / (1024 * 1024):8.2f} MB/s"
+    return text
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Canvas benchmarks")
+    ap.add_argument("--bin", default="./cv", help="Path to Canvas binary")
+    ap.add_argument("--baseline", default="", help="Optional second binary to compare against")
+    ap.add_argument("--runs", type=int, default=0, help="Override the number of runs per case")
+    ap.add_argument("--tags", nargs="*", default=[], help="Run only cases matching any of these tags")
+    ap.add_argument("--only", nargs="*", default=[], help="Run only cases whose names contain one of these fragments")
+    args = ap.parse_args()
+
+    binaries = [("bin", str(Path(args.bin).resolve()))]
+    if args.baseline:
+        binaries.append(("baseline", str(Path(args.baseline).resolve())))
+
+    cases = build_cases()
+    if args.tags:
+        wanted = set(args.tags)
+        cases = [c for c in cases if c.tags & wanted or "startup" in c.tags]
+    if args.only:
+        cases = [c for c in cases if any(f in c.name for f in args.only) or "startup" in c.tags]
+
+    print("STARTING CANVAS BENCHMARKS")
+
+    failed = 0
+    skipped = 0
+    startup = {}
+    for case in cases:
+        runs = args.runs if args.runs > 0 else case.runs
+        results = {}
+        for label, binary in binaries:
+            missing = [f for f in case.needs if not supports(binary, f)]
+            if missing:
+                skipped += 1
+                print(f"[{case.name}] {label:8} | SKIPPED (no {', '.join(missing)})")
+                continue
+            result = run_case(binary, case, runs)
+            results[label] = result
+            if "startup" in case.tags and result.ok:
+                startup[label] = result.best
+            if not result.ok:
+                failed += 1
+            print(f"[{case.name}] {label:8} | {describe(result, startup.get(label, 0.0))}")
+        if len(results) > 1 and all(r.ok for r in results.values()):
+            ratio = results["baseline"].best / results["bin"].best if results["bin"].best > 0 else 0.0
+            print(f"[{case.name}] speedup  | {ratio:.2f}x")
+
+    print(f"\nDONE. {len(cases)} CASE(S) | {failed} FAILURE(S) | {skipped} SKIPPED")
+    raise SystemExit(0 if failed == 0 else 1)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,170 @@
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include "CV.hpp"
+
+/*
+    Benchmarks for embedding hosts, the things Benchmark.py can't see from outside the process. Built only with
+    -DCV_BUILD_BENCHMARKS=ON. Usage: cv_bench [--runs N] [NAME FRAGMENT...]
+*/
+
+struct BenchCase {
+	std::string name;
+	int iterations;
+	std::function<void()> setup;
+	std::function<bool()> body;
+};
+
+static double now(){
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static std::vector<BenchCase> buildCases(){
+	std::vector<BenchCase> cases;
+
+	// One fresh context per request, the way a server embedding canvas would
+	cases.push_back({"context:setup", 100000, [](){}, [](){
+		auto context = CV::MakeRef<CV::Context>();
+		CV::CoreSetup(context);
+		return context->getNamed("+").second != nullptr;
+	}});
+
+	auto cursor = CV::MakeRef<CV::Cursor>();
+	auto root = std::make_shared<std::vector<CV::TokenType>>();
+	cases.push_back({"context:setup-and-run", 100000, [cursor, root](){
+		*root = CV::BuildTree("[+ 1 2]", cursor);
+	}, [cursor, root](){
+		auto context = CV::MakeRef<CV::Context>();
+		CV::CoreSetup(context);
+		auto cf = CV::MakeRef<CV::ControlFlow>();
+		cf->state = CV::ControlFlowState::CONTINUE;
+		CV::Interpret((*root)[0], cursor, cf, context);
+		return !cursor->error;
+	}});
+
+	/*
+		A context configured once (helpers and a counter), then a request that bumps the counter and binds a name
+		of its own. Forking must leave the base untouched for every request, rebuilding pays for the setup each time
+	*/
+	auto base = CV::MakeRef<CV::Context>();
+	auto setup = std::make_shared<std::vector<CV::TokenType>>();
+	auto request = std::make_shared<std::vector<CV::TokenType>>();
+	auto run = [cursor](const std::vector<CV::TokenType> &tokens, const CV::ContextType &context){
+		CV::Ref<CV::Data> result;
+		for(auto &token : tokens){
+			auto cf = CV::MakeRef<CV::ControlFlow>();
+			cf->state = CV::ControlFlowState::CONTINUE;
+			result = CV::Interpret(token, cursor, cf, context);
+		}
+		return result;
+	};
+	auto expectOne = [cursor](const CV::Ref<CV::Data> &result){
+		return !cursor->error && result && result->type == CV::DataType::NUMBER &&
+			CV::CastRef<CV::DataNumber>(result)->v == 1;
+	};
+	auto prepare = [cursor, base, setup, request, run](){
+		if(!setup->empty()){
+			return;
+		}
+		std::string source = "[let count 0] [let bump [fn [x] [+ x 1]]]";
+		for(int i = 0; i < 30; ++i){
+			source += " [let helper"+std::to_string(i)+" [fn [x] [* x "+std::to_string(i)+"]]]";
+		}
+		*setup = CV::BuildTree(source, cursor);
+		*request = CV::BuildTree("[let mine 5] [mut count [bump count]] [count]", cursor);
+		CV::CoreSetup(base);
+		run(*setup, base);
+	};
+	cases.push_back({"context:fork-and-run", 20000, prepare, [base, request, run, expectOne](){
+		return expectOne(run(*request, base->fork()));
+	}});
+	cases.push_back({"context:rebuild-and-run", 20000, prepare, [setup, request, run, expectOne](){
+		auto context = CV::MakeRef<CV::Context>();
+		CV::CoreSetup(context);
+		run(*setup, context);
+		return expectOne(run(*request, context));
+	}});
+
+	/*
+		A small rule evaluated per event with the event's fields as inputs: parsed every time (what hosts had to do
+		before Program), or parsed once and run through a Program on each engine
+	*/
+	static const std::string rule = "[if [and [> amount 100] [< risk 5]] [* amount 0.02] 0]";
+	auto host = CV::MakeRef<CV::Context>();
+	CV::CoreSetup(host);
+	auto expectFee = [cursor](const CV::Ref<CV::Data> &result){
+		return !cursor->error && result && result->type == CV::DataType::NUMBER &&
+			CV::CastRef<CV::DataNumber>(result)->v == 3;
+	};
+	auto inputs = [host](){
+		return std::vector<std::pair<std::string, CV::Ref<CV::Data>>>{
+			{"amount", host->buildNumber(150)},
+			{"risk", host->buildNumber(2)}
+		};
+	};
+	cases.push_back({"program:rule-reparse", 100000, [](){}, [cursor, host, inputs, expectFee](){
+		auto context = host->buildContext(true);
+		for(auto &input : inputs()){
+			context->setNamed(input.first, input.second);
+		}
+		auto cf = CV::MakeRef<CV::ControlFlow>();
+		cf->state = CV::ControlFlowState::CONTINUE;
+		return expectFee(CV::Interpret(CV::BuildTree(rule, cursor)[0], cursor, cf, context));
+	}});
+	std::vector<std::pair<std::string, int>> engines = {{"interpreter", CV::Engine::INTERPRETER}, {"vm", CV::Engine::VM}};
+	for(auto &it : engines){
+		auto engine = it.second;
+		auto program = std::make_shared<CV::ProgramType>();
+		cases.push_back({"program:rule-run:"+it.first, 100000, [cursor, program, engine](){
+			*program = CV::BuildProgram(rule, cursor, engine);
+		}, [cursor, host, program, inputs, expectFee](){
+			return expectFee((*program)->run(host, inputs(), cursor));
+		}});
+	}
+
+	return cases;
+}
+
+int main(int argc, char* argv[]){
+	int runs = 5;
+	std::vector<std::string> only;
+	for(int i = 1; i < argc; ++i){
+		std::string arg = argv[i];
+		if(arg == "--runs" && i < argc - 1){
+			runs = std::max(1, std::stoi(argv[++i]));
+		}else{
+			only.push_back(arg);
+		}
+	}
+
+	printf("STARTING CANVAS EMBEDDING BENCHMARKS\n");
+
+	int failed = 0;
+	auto cases = buildCases();
+	for(auto &c : cases){
+		if(!only.empty() && std::none_of(only.begin(), only.end(), [&](const std::string &f){ return c.name.find(f) != std::string::npos; })){
+			continue;
+		}
+		c.setup();
+		std::vector<double> times;
+		bool ok = true;
+		for(int r = 0; r < runs && ok; ++r){
+			auto started = now();
+			for(int i = 0; i < c.iterations && ok; ++i){
+				ok = c.body();
+			}
+			times.push_back(now() - started);
+		}
+		if(!ok){
+			++failed;
+			printf("[%s] FAILURE\n", c.name.c_str());
+			continue;
+		}
+		std::sort(times.begin(), times.end());
+		printf("[%s] best %9.2f ms | median %9.2f ms | %10.0f ops/s\n",
+			c.name.c_str(), times.front() * 1000.0, times[times.size() / 2] * 1000.0, c.iterations / times.front());
+	}
+
+	printf("\nDONE. %d FAILURE(S)\n", failed);
+	return failed == 0 ? 0 : 1;
+}
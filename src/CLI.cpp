@@ -16,6 +16,27 @@ struct ExecArg {
 	}
 };
 
+// Printed to stderr however the process ends
+static bool useCacheStats = false;
+static bool useAllocStats = false;
+static bool useCollectorStats = false;
+
+static void printStats(){
+	if(useCacheStats){
+		auto stats = CV::GetNameCacheStats();
+		fprintf(stderr, "name cache: %llu hits, %llu misses\n", (unsigned long long)stats.hits, (unsigned long long)stats.misses);
+	}
+	if(useAllocStats){
+		fprintf(stderr, "data allocations: %llu\n", (unsigned long long)CV::GetDataAllocations());
+	}
+	if(useCollectorStats){
+		auto stats = CV::GetCollectorStats();
+		fprintf(stderr, "collector: %llu collected in %llu collections, %llu tracked, %llu live, pauses %.3f ms max %.3f ms total\n",
+			(unsigned long long)stats.collected, (unsigned long long)stats.collections, (unsigned long long)stats.tracked,
+			(unsigned long long)stats.live, stats.maxPause * 1000.0, stats.totalPause * 1000.0);
+	}
+}
+
 static std::shared_ptr<ExecArg> getParam(std::vector<std::string> &params, const std::string &name, bool single = false){
 	auto v = std::make_shared<ExecArg>(name);
 	for(int i = 0; i < params.size(); ++i){
@@ -23,7 +44,7 @@ static std::shared_ptr<ExecArg> getParam(std::vector<std::string> &params, const
 			if(i < params.size()-1 && !single){
 				v->val = params[i + 1];
 				v->valid = true;
-				params.erase(params.begin() + i, params.begin() + i + 1);
+				params.erase(params.begin() + i, params.begin() + i + 2);
 			}else{
 				v->valid = single;
 				params.erase(params.begin() + i);
@@ -48,12 +69,49 @@ int main(int argc, char* argv[]){
 	bool useVersion = getParam(params, "-v", true)->valid || getParam(params, "--version", true)->valid; 
 	bool useRelaxed = getParam(params, "-r", true)->valid || getParam(params, "--relaxed", true)->valid; 
 	bool useNoReturn = getParam(params, "-u", true)->valid || getParam(params, "--no-return", true)->valid; 
+	bool usePrecompile = getParam(params, "--precompile", true)->valid;
+	bool useImportOnce = getParam(params, "--import-once", true)->valid;
+	useCacheStats = getParam(params, "--cache-stats", true)->valid;
+	useAllocStats = getParam(params, "--alloc-stats", true)->valid;
+	useCollectorStats = getParam(params, "--gc-stats", true)->valid;
+	std::atexit(printStats);
 
 	// File
 	auto dashF = getParam(params, "-f", false);
 	auto dashFile = getParam(params, "--file", false);
 	std::string useFile = dashF->valid ? dashF->val : (dashFile->valid ? dashFile->val : "");
 
+	// Collector
+	auto dashThreshold = getParam(params, "--gc-threshold", false);
+	if(dashThreshold->valid){
+		auto &threshold = dashThreshold->val;
+		if(threshold.empty() || threshold.size() > 18 || threshold.find_first_not_of("0123456789") != std::string::npos){
+			printf("Invalid collector threshold '%s'. Expected a number of containers, 0 turns collections off\n", threshold.c_str());
+			return 1;
+		}
+		CV::SetCollectorThresholds(std::stoull(threshold));
+	}
+
+	// Engine
+	auto dashEngine = getParam(params, "--engine", false);
+	int useEngine = CV::Engine::INTERPRETER;
+	if(dashEngine->valid){
+		if(CV::Tools::lower(dashEngine->val) == "vm"){
+			useEngine = CV::Engine::VM;
+		}else
+		if(CV::Tools::lower(dashEngine->val) != "interpreter"){
+			printf("Unknown engine '%s'. Available engines are 'interpreter' and 'vm'\n", dashEngine->val.c_str());
+			return 1;
+		}
+	}
+
+	auto run = [&](const CV::TokenType &token, const CV::CursorType &cursor, const CV::ControlFlowType &cf, const CV::ContextType &context){
+		if(useEngine == CV::Engine::VM){
+			return CV::Execute(token, cursor, cf, context);
+		}
+		return CV::Interpret(token, cursor, cf, context);
+	};
+
 	// Version Info
 	auto printVersion = [&](bool nl = true, const std::string &mode = ""){
 		std::string text = std::string("canvas%s v%.0f.%.0f.%.0f %s [%s] released in %s")+
@@ -79,6 +137,12 @@ int main(int argc, char* argv[]){
 	}
 
 	CV::SetUseColor(useColor);	
+	CV::SetModuleReuse(useImportOnce);
+
+	if(usePrecompile && useFile.empty()){
+		printf("Nothing to precompile. Use \"--precompile -f FILE\" to write FILE's parsed tree next to it\n");
+		return 1;
+	}
 
 	if(useREPL && useFile.size() > 0){
 		printf("REPL cannot be used while reading a file. Start REPL mode and import a file by using \"[bring LIBRAY]\"\n");
@@ -93,55 +157,66 @@ int main(int argc, char* argv[]){
             return 1;
         }
 
-        auto cursor = std::make_shared<CV::Cursor>();
-        auto context = std::make_shared<CV::Context>();
+        auto cursor = CV::MakeRef<CV::Cursor>();
 
-        CV::CoreSetup(context);
+        // Only writes the '.cvc', running the script is up to whoever loads it next
+        if(usePrecompile){
+            if(!CV::Precompile(useFile, cursor)){
+                std::cout << cursor->getRaised() << std::endl;
+                return 1;
+            }
+            return 0;
+        }
+
+        auto context = CV::MakeRef<CV::Context>();
 
-        auto file = CV::Tools::readFile(useFile);
+        CV::CoreSetup(context);
 
-        auto root = CV::BuildTree(file, cursor);
+        auto root = CV::LoadTree(useFile, cursor);
         if(cursor->error){
             std::cout << cursor->getRaised() << std::endl;
             return 1;
         }
 
-        std::shared_ptr<CV::Data> result = context->buildNil();
+        CV::Ref<CV::Data> result = context->buildNil();
 
         for(int i = 0; i < static_cast<int>(root.size()); ++i){
-            auto cf = std::make_shared<CV::ControlFlow>();
+            auto cf = CV::MakeRef<CV::ControlFlow>();
             cf->state = CV::ControlFlowState::CONTINUE;
 
-            result = CV::Interpret(root[i], cursor, cf, context);
+            result = run(root[i], cursor, cf, context);
             if(cursor->error){
                 std::cout << cursor->getRaised() << std::endl;
                 return 1;
             }
         }
 
-        (void)result;
+        // Whatever the script left in cycles outlives its context, free it along with everything else it built
+        result = nullptr;
+        context = nullptr;
+        CV::Collect();
         return 0;
     }else
     // REPL
     if(useREPL){
-        auto cursor = std::make_shared<CV::Cursor>();
-        auto context = std::make_shared<CV::Context>();
+        auto cursor = CV::MakeRef<CV::Cursor>();
+        auto context = CV::MakeRef<CV::Context>();
 
         // Persistent REPL root context
         CV::CoreSetup(context);
 
         // Easy "exit" function for REPL
         context->registerFunction("exit",
-            [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-               const std::shared_ptr<CV::Context> &ctx,
+            [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+               const CV::Ref<CV::Context> &ctx,
                const CV::CursorType &cursor,
-               const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+               const CV::TokenType &token) -> CV::Ref<CV::Data> {
                 (void)args;
                 (void)ctx;
                 (void)cursor;
                 (void)token;
                 std::exit(0);
-                return std::shared_ptr<CV::Data>(nullptr);
+                return CV::Ref<CV::Data>(nullptr);
             }
         );
 
@@ -150,12 +225,15 @@ int main(int argc, char* argv[]){
         linenoise::SetCompletionCallback([&](const char* editBuffer, std::vector<std::string>& completions){
             std::string prefix = editBuffer ? std::string(editBuffer) : "";
 
-            for(const auto &it : context->data){
-                if(prefix.empty()){
-                    completions.push_back(it.first);
-                }else{
-                    if(it.first.rfind(prefix, 0) == 0){
-                        completions.push_back(it.first);
+            for(auto c = context.get(); c; c = c->head.get()){
+                for(const auto &it : c->data){
+                    auto &name = CV::SymbolName(it.first);
+                    if(prefix.empty()){
+                        completions.push_back(name);
+                    }else{
+                        if(name.rfind(prefix, 0) == 0){
+                            completions.push_back(name);
+                        }
                     }
                 }
             }
@@ -165,7 +243,7 @@ int main(int argc, char* argv[]){
         linenoise::SetHistoryMaxLen(1000);
 
         while(true){
-            auto cf = std::make_shared<CV::ControlFlow>();
+            auto cf = CV::MakeRef<CV::ControlFlow>();
             cf->state = CV::ControlFlowState::CONTINUE;
 
             std::string input = "";
@@ -195,13 +273,13 @@ int main(int argc, char* argv[]){
                 }
             }
 
-            std::shared_ptr<CV::Data> result = context->buildNil();
+            CV::Ref<CV::Data> result = context->buildNil();
 
             for(int i = 0; i < static_cast<int>(root.size()); ++i){
-                cf = std::make_shared<CV::ControlFlow>();
+                cf = CV::MakeRef<CV::ControlFlow>();
                 cf->state = CV::ControlFlowState::CONTINUE;
 
-                result = CV::Interpret(root[i], cursor, cf, context);
+                result = run(root[i], cursor, cf, context);
                 if(cursor->error){
                     break;
                 }
@@ -220,6 +298,9 @@ int main(int argc, char* argv[]){
             if(!useNoReturn){
                 std::cout << CV::DataToText(result) << std::endl;
             }
+
+            // Between inputs nothing is running, whatever got dropped in a cycle goes now
+            CV::Collect();
         }
 
         return cursor->error && !useRelaxed ? 1 : 0;
@@ -238,8 +319,8 @@ int main(int argc, char* argv[]){
             return 0;
         }
 
-        auto cursor = std::make_shared<CV::Cursor>();
-        auto context = std::make_shared<CV::Context>();
+        auto cursor = CV::MakeRef<CV::Cursor>();
+        auto context = CV::MakeRef<CV::Context>();
 
         CV::CoreSetup(context);
 
@@ -249,13 +330,13 @@ int main(int argc, char* argv[]){
             return 1;
         }
 
-        std::shared_ptr<CV::Data> result = context->buildNil();
+        CV::Ref<CV::Data> result = context->buildNil();
 
         for(int i = 0; i < static_cast<int>(root.size()); ++i){
-            auto cf = std::make_shared<CV::ControlFlow>();
+            auto cf = CV::MakeRef<CV::ControlFlow>();
             cf->state = CV::ControlFlowState::CONTINUE;
 
-            result = CV::Interpret(root[i], cursor, cf, context);
+            result = run(root[i], cursor, cf, context);
             if(cursor->error){
                 std::cout << cursor->getRaised() << std::endl;
                 return 1;
@@ -266,6 +347,9 @@ int main(int argc, char* argv[]){
             std::cout << CV::DataToText(result) << std::endl;
         }
 
+        result = nullptr;
+        context = nullptr;
+        CV::Collect();
         return 0;
     }
 
@@ -1,9 +1,17 @@
 #include <iostream>
 #include <stdio.h>
 #include <stdarg.h>
+#include <stdlib.h>
 #include <functional>
 #include <sys/stat.h>
 #include <fstream>
+#include <unordered_set>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <chrono>
+#include <atomic>
+#include <shared_mutex>
 
 // DYNAMIC LIBRARY STUFF
 #if (_CV_PLATFORM == _CV_PLATFORM_TYPE_LINUX)
@@ -13,12 +21,45 @@
     #include <Libloaderapi.h>
 #endif
 
+// PRECOMPILED TREES ARE MAPPED IN
+#if (_CV_PLATFORM == _CV_PLATFORM_TYPE_LINUX) || (_CV_PLATFORM == _CV_PLATFORM_TYPE_OSX)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+#endif
+
 #include "CV.hpp"
 
 
 static bool UseColorOnText = true;
 static std::string CV_LIB_HOME = "./";
 
+/*
+    Inline name caches: each thread remembers, per token, where the token's name was last found from a given
+    context. They're kept aside in a small direct-mapped table rather than on the tokens, which any number of
+    threads may be running at once (a Program, an imported module). Binding a new name into a context some cache
+    walked through (or one that's shared: frozen, builtins) bumps the version and invalidates every cache at once.
+    Contexts no cache ever looked into bind freely, whatever thread they're on. Hits and misses are counted per thread
+*/
+#define CV_NAME_CACHE_SIZE 1024
+
+struct __cv_name_cache {
+    const CV::Token *token;
+    CV::Symbol symbol;
+    uint64_t context;
+    uint64_t version;
+    uint64_t serial;
+    const CV::Ref<CV::Data> *slot;
+    // A fork lies between the context the cache is keyed to and where the name was found
+    bool crossed;
+};
+
+static std::atomic<uint64_t> __cv_context_serial(0);
+static std::atomic<uint64_t> __cv_names_version(0);
+static thread_local __cv_name_cache __cv_name_caches[CV_NAME_CACHE_SIZE] = {};
+static thread_local CV::NameCacheStats __cv_name_cache_stats = {0, 0};
+
+
 static int GEN_ID(){
     static std::mutex access;
     static int v = 0;
@@ -152,16 +193,11 @@ namespace CV {
         }
 
         bool isReservedWord(const std::string &name){
-            static const std::vector<std::string> reserved {
+            static const std::unordered_set<std::string> reserved {
                 "let", "import", "import:dynamic-library", "~", ".", "|", "`", "cc", "mut", "fn",
                 "return", "yield", "skip", "b:list", "b:store", "await"
             };
-            for(int i = 0; i < reserved.size(); ++i){
-                if(reserved[i] == name){
-                    return true;
-                }
-            }
-            return false;
+            return reserved.count(name) > 0;
         }
 
         static std::string removeTrailingZeros(double d){
@@ -256,8 +292,10 @@ namespace CV {
 
         bool fileExists(const std::string &path){
 			struct stat tt;
-			stat(path.c_str(), &tt);
-			return S_ISREG(tt.st_mode);	            
+			if(stat(path.c_str(), &tt) != 0){
+				return false;
+			}
+			return S_ISREG(tt.st_mode);
         }
         
 		std::string fileExtension(const std::string &filename){
@@ -274,7 +312,7 @@ namespace CV {
             return false;
         }   
         
-        bool isInList(const std::string &v, const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &list){
+        bool isInList(const std::string &v, const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &list){
             for(int i = 0; i < list.size(); ++i){
                 if(list[i].first == v){
                     return true;
@@ -312,12 +350,12 @@ void CV::Cursor::clear(){
     this->used = false;
     this->shouldExit = true;
     this->autoprint = true;
-    this->subject = CV::TokenType(NULL);
+    this->subject = nullptr;
     this->message = "";
     accessMutex.unlock();
 }
 
-void CV::Cursor::setError(const std::string &title, const std::string &message, const std::shared_ptr<CV::Token> &subject){
+void CV::Cursor::setError(const std::string &title, const std::string &message, const CV::Ref<CV::Token> &subject){
     accessMutex.lock();
     this->title = title;
     this->message = message;
@@ -384,17 +422,477 @@ void  CV::Cursor::reset(){
     error = false;
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  SYMBOLS
+// 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+    Names are handed out in order of first appearance and never taken back. Symbol 0 is always the empty name.
+    Any thread may intern: lookups share the table's lock, only new names take it for themselves. Their text lives
+    in blocks that never move once published, so SymbolName reads it without locking and the references it hands
+    out stay good for good
+*/
+static const std::size_t CV_SYMBOL_BLOCK = 1024;
+static const std::size_t CV_SYMBOL_BLOCKS = 4096;
+
+struct __cv_symbol_table {
+    std::shared_mutex mutex;
+    std::unordered_map<std::string, CV::Symbol> ids;
+    std::atomic<std::string*> blocks[CV_SYMBOL_BLOCKS];
+    std::size_t size;
+    __cv_symbol_table(){
+        for(auto &block : blocks){
+            block.store(nullptr, std::memory_order_relaxed);
+        }
+        size = 0;
+        add("");
+    }
+    // With the lock held for itself
+    CV::Symbol add(const std::string &name){
+        if(size == CV_SYMBOL_BLOCK * CV_SYMBOL_BLOCKS){
+            fprintf(stderr, "Too many names: every one of the %zu symbols is taken\n", size);
+            std::abort();
+        }
+        auto block = blocks[size / CV_SYMBOL_BLOCK].load(std::memory_order_relaxed);
+        if(!block){
+            block = new std::string[CV_SYMBOL_BLOCK];
+            blocks[size / CV_SYMBOL_BLOCK].store(block, std::memory_order_release);
+        }
+        block[size % CV_SYMBOL_BLOCK] = name;
+        auto symbol = static_cast<CV::Symbol>(size++);
+        ids.emplace(name, symbol);
+        return symbol;
+    }
+};
+
+// Never destroyed, names may still be read while the process exits
+static __cv_symbol_table &__cv_symbols(){
+    static auto table = new __cv_symbol_table();
+    return *table;
+}
+
+// Like Intern, without making up a symbol for a name that doesn't have one yet
+static bool __cv_find_symbol(const std::string &name, CV::Symbol &symbol){
+    auto &table = __cv_symbols();
+    std::shared_lock<std::shared_mutex> lock(table.mutex);
+    auto it = table.ids.find(name);
+    if(it == table.ids.end()){
+        return false;
+    }
+    symbol = it->second;
+    return true;
+}
+
+CV::Symbol CV::Intern(const std::string &name){
+    CV::Symbol symbol;
+    if(__cv_find_symbol(name, symbol)){
+        return symbol;
+    }
+    auto &table = __cv_symbols();
+    std::unique_lock<std::shared_mutex> lock(table.mutex);
+    // Someone else may have added it in between
+    auto it = table.ids.find(name);
+    if(it != table.ids.end()){
+        return it->second;
+    }
+    return table.add(name);
+}
+
+const std::string &CV::SymbolName(CV::Symbol symbol){
+    auto block = __cv_symbols().blocks[symbol / CV_SYMBOL_BLOCK].load(std::memory_order_acquire);
+    return block[symbol % CV_SYMBOL_BLOCK];
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
 //  TYPES
 // 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+//
+// CYCLE COLLECTOR
+//
+/*
+    References are counted, so a list pushed into itself ('>>' changes lists in place) or two stores holding each
+    other never go away. Functions don't take part: they hold no context of their own, calls run in the caller's.
+    A cycle can only close when a list, store, proxy or context gets put into one that already exists, so that's
+    the one watched (once) from then on. A collection walks everything reachable from the watched containers and
+    takes away, for each one, the references coming from inside that graph (trial deletion). Whatever is left
+    with none is only kept alive by cycles: its contents are cleared, which lets reference counting free it all.
+    References held by C++ (hosts, the VM stack, running frames) always count as outside ones, and so does anything
+    shared with other threads, which is never watched nor walked into
+*/
+// Shared by every thread's collector
+static std::atomic<uint64_t> __cv_gc_pending_threshold(100);
+static std::atomic<uint64_t> __cv_gc_growth_threshold(25);
+
+// Trivially destructible, tells containers going away after the thread's collector that there's nothing to leave
+static thread_local bool __cv_gc_gone = false;
+
+struct __cv_gc_state {
+    // Not held, a watched container going away takes itself off (__cv_gc_forget)
+    std::unordered_set<CV::Data*> tracked;
+    uint64_t pending = 0;
+    uint64_t survivors = 0;
+    bool collecting = false;
+    ~__cv_gc_state(){
+        __cv_gc_gone = true;
+    }
+};
+static thread_local __cv_gc_state __cv_gc;
+// Trivially destructible, so it can still be read at exit once the thread's state is gone
+static thread_local CV::CollectorStats __cv_gc_stats = {0, 0, 0, 0, 0, 0, 0};
+
+static bool __cv_gc_container(const CV::Data *d){
+    return d && !d->shared() && (
+        d->type == CV::DataType::LIST ||
+        d->type == CV::DataType::STORE ||
+        d->type == CV::DataType::PROXY ||
+        d->type == CV::DataType::CONTEXT
+    );
+}
+
+/*
+    Graph nodes are containers, list chunks and store members: copies made by 'cc' share those last two, so the
+    items in them are held once whatever the number of lists or stores that can reach them
+*/
+struct __cv_gc_node {
+    CV::Ref<CV::Counted> hold;
+    CV::Data *data;
+    CV::ListChunk *chunk;
+    CV::StoreMembers *members;
+};
+
+static bool __cv_gc_member(const CV::Data *d){
+    return __cv_gc_container(d);
+}
+
+static bool __cv_gc_member(const CV::ListChunk *chunk){
+    return chunk && !chunk->shared();
+}
+
+static bool __cv_gc_member(const CV::StoreMembers *members){
+    return members && !members->shared();
+}
+
+static const void *__cv_gc_key(const CV::Data *d){
+    return d;
+}
+
+static const void *__cv_gc_key(const CV::ListChunk *chunk){
+    return chunk;
+}
+
+static const void *__cv_gc_key(const CV::StoreMembers *members){
+    return members;
+}
+
+static __cv_gc_node __cv_gc_make_node(const CV::Ref<CV::Data> &ref){
+    return {ref, ref.get(), nullptr, nullptr};
+}
+
+static __cv_gc_node __cv_gc_make_node(const CV::Ref<CV::ListChunk> &ref){
+    return {ref, nullptr, ref.get(), nullptr};
+}
+
+static __cv_gc_node __cv_gc_make_node(const CV::Ref<CV::StoreMembers> &ref){
+    return {ref, nullptr, nullptr, ref.get()};
+}
+
+// Calls 'visit' with every reference 'node' holds
+template<typename F>
+static void __cv_gc_edges(const __cv_gc_node &node, const F &visit){
+    if(node.chunk){
+        for(auto &item : node.chunk->items){
+            visit(item);
+        }
+        return;
+    }
+    if(node.members){
+        for(auto &it : node.members->items){
+            visit(it.second);
+        }
+        return;
+    }
+    auto d = node.data;
+    switch(d->type){
+        case CV::DataType::LIST: {
+            auto &items = static_cast<CV::DataList*>(d)->v;
+            for(auto &chunk : items.chunks){
+                visit(chunk);
+            }
+            for(auto &item : items.tail){
+                visit(item);
+            }
+        } break;
+        case CV::DataType::STORE: {
+            auto &items = static_cast<CV::DataStore*>(d)->v;
+            visit(items.shared);
+            for(auto &it : items.own){
+                visit(it.second);
+            }
+        } break;
+        case CV::DataType::PROXY: {
+            visit(static_cast<CV::DataProxy*>(d)->target);
+        } break;
+        case CV::DataType::CONTEXT: {
+            auto ctx = static_cast<CV::Context*>(d);
+            visit(ctx->head);
+            for(auto &it : ctx->data){
+                visit(it.second);
+            }
+        } break;
+        default:
+            break;
+    }
+}
+
+static void __cv_gc_clear(const __cv_gc_node &node){
+    if(node.chunk){
+        for(auto &item : node.chunk->items){
+            item.reset();
+        }
+        return;
+    }
+    if(node.members){
+        node.members->items.clear();
+        return;
+    }
+    auto d = node.data;
+    switch(d->type){
+        case CV::DataType::LIST: {
+            static_cast<CV::DataList*>(d)->v.clear();
+        } break;
+        case CV::DataType::STORE: {
+            static_cast<CV::DataStore*>(d)->v.clear();
+        } break;
+        case CV::DataType::PROXY: {
+            static_cast<CV::DataProxy*>(d)->target.reset();
+        } break;
+        case CV::DataType::CONTEXT: {
+            auto ctx = static_cast<CV::Context*>(d);
+            ctx->head.reset();
+            ctx->data.clear();
+            ctx->namedNames.clear();
+        } break;
+        default:
+            break;
+    }
+}
+
+static uint64_t __cv_gc_collect(){
+    auto &gc = __cv_gc;
+    if(gc.collecting){
+        return 0;
+    }
+    gc.collecting = true;
+    auto started = std::chrono::steady_clock::now();
+
+    // Everything reachable from the watched containers, each held once more by 'nodes' while this runs
+    std::vector<__cv_gc_node> nodes;
+    std::unordered_map<const void*, std::size_t> index;
+    auto reach = [&](const auto &ref){
+        if(__cv_gc_member(ref.get()) && index.emplace(__cv_gc_key(ref.get()), nodes.size()).second){
+            nodes.push_back(__cv_gc_make_node(ref));
+        }
+    };
+    for(auto watched : gc.tracked){
+        reach(CV::Ref<CV::Data>(watched));
+    }
+    for(std::size_t i = 0; i < nodes.size(); ++i){
+        auto node = nodes[i];
+        __cv_gc_edges(node, reach);
+    }
+
+    // References from outside the graph
+    std::vector<long> outside(nodes.size());
+    for(std::size_t i = 0; i < nodes.size(); ++i){
+        outside[i] = nodes[i].hold.use_count() - 1;
+    }
+    for(std::size_t i = 0; i < nodes.size(); ++i){
+        __cv_gc_edges(nodes[i], [&](const auto &ref){
+            auto it = index.find(__cv_gc_key(ref.get()));
+            if(it != index.end()){
+                --outside[it->second];
+            }
+        });
+    }
+
+    // Anything referred to from outside is alive, and so is everything it reaches
+    std::vector<bool> alive(nodes.size(), false);
+    std::vector<std::size_t> pending;
+    for(std::size_t i = 0; i < nodes.size(); ++i){
+        if(outside[i] > 0){
+            alive[i] = true;
+            pending.push_back(i);
+        }
+    }
+    while(!pending.empty()){
+        auto i = pending.back();
+        pending.pop_back();
+        __cv_gc_edges(nodes[i], [&](const auto &ref){
+            auto it = index.find(__cv_gc_key(ref.get()));
+            if(it != index.end() && !alive[it->second]){
+                alive[it->second] = true;
+                pending.push_back(it->second);
+            }
+        });
+    }
+
+    uint64_t collected = 0;
+    for(std::size_t i = 0; i < nodes.size(); ++i){
+        if(!alive[i]){
+            __cv_gc_clear(nodes[i]);
+            collected += nodes[i].data != nullptr;
+        }
+    }
+    nodes.clear();
+
+    gc.pending = 0;
+    gc.survivors = gc.tracked.size();
+
+    double pause = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    auto &stats = __cv_gc_stats;
+    stats.collections += 1;
+    stats.collected += collected;
+    stats.tracked = gc.tracked.size();
+    stats.lastPause = pause;
+    stats.maxPause = std::max(stats.maxPause, pause);
+    stats.totalPause += pause;
+    gc.collecting = false;
+    return collected;
+}
+
+// 'container' just got a list, store, proxy or context put in it
+static void __cv_gc_watch(const CV::Ref<CV::Data> &container){
+    if(container->tracked || container->shared() || __cv_gc_gone){
+        return;
+    }
+    container->tracked = true;
+    auto &gc = __cv_gc;
+    gc.tracked.insert(container.get());
+    __cv_gc_stats.tracked = gc.tracked.size();
+    ++gc.pending;
+    if(__cv_gc_pending_threshold > 0 && gc.pending >= __cv_gc_pending_threshold &&
+       gc.pending * 100 >= gc.survivors * __cv_gc_growth_threshold){
+        __cv_gc_collect();
+    }
+}
+
+// A watched container going away, or being shared
+static void __cv_gc_forget(CV::Data *container){
+    container->tracked = false;
+    if(__cv_gc_gone){
+        return;
+    }
+    auto &gc = __cv_gc;
+    gc.tracked.erase(container);
+    __cv_gc_stats.tracked = gc.tracked.size();
+}
+
+//
+// DATA COUNTS
+//
+/*
+    Every Data built and destroyed (contexts included), for GetDataAllocations and GetCollectorStats. Each thread
+    counts its own so building a value never writes to memory another thread uses. Readers add up the threads
+    still running and what the ones gone left behind. Counting starts the first time a thread builds something
+*/
+namespace DataCounting {
+    enum DataCounting : int {
+        IDLE,
+        COUNTING,
+        GONE
+    };
+}
+
+struct __cv_data_counts {
+    // Only ever written by their own thread
+    std::atomic<uint64_t> built;
+    std::atomic<uint64_t> destroyed;
+    int state;
+};
+
+struct __cv_data_threads {
+    std::mutex mutex;
+    std::vector<__cv_data_counts*> counting;
+    std::atomic<uint64_t> built;
+    std::atomic<uint64_t> destroyed;
+};
+
+// Never destroyed, values going away during exit still get counted
+static __cv_data_threads &__cv_data_registry(){
+    static auto registry = new __cv_data_threads();
+    return *registry;
+}
+
+// Trivially destructible, usable until the thread is gone
+static thread_local __cv_data_counts __cv_data_counted = {};
+
+struct __cv_data_reaper {
+    bool joined = false;
+    ~__cv_data_reaper(){
+        auto &registry = __cv_data_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto &counting = registry.counting;
+        counting.erase(std::remove(counting.begin(), counting.end(), &__cv_data_counted), counting.end());
+        registry.built += __cv_data_counted.built.load(std::memory_order_relaxed);
+        registry.destroyed += __cv_data_counted.destroyed.load(std::memory_order_relaxed);
+        __cv_data_counted.state = DataCounting::GONE;
+    }
+};
+static thread_local __cv_data_reaper __cv_data_reaping;
+
+static void __cv_count_data(bool built){
+    auto &counts = __cv_data_counted;
+    if(counts.state == DataCounting::IDLE){
+        __cv_data_reaping.joined = true;
+        auto &registry = __cv_data_registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.counting.push_back(&counts);
+        counts.state = DataCounting::COUNTING;
+    }
+    if(counts.state == DataCounting::GONE){
+        (built ? __cv_data_registry().built : __cv_data_registry().destroyed).fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    auto &n = built ? counts.built : counts.destroyed;
+    n.store(n.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+static void __cv_data_totals(uint64_t &built, uint64_t &destroyed){
+    auto &registry = __cv_data_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    built = registry.built.load(std::memory_order_relaxed);
+    destroyed = registry.destroyed.load(std::memory_order_relaxed);
+    for(auto counts : registry.counting){
+        built += counts->built.load(std::memory_order_relaxed);
+        destroyed += counts->destroyed.load(std::memory_order_relaxed);
+    }
+}
+
 //
 // DATA (NIL)
 //
 CV::Data::Data(){
     this->type = CV::DataType::NIL;
+    this->tracked = false;
+    __cv_count_data(true);
+}
+
+CV::Data::Data(const CV::Data &other){
+    this->type = other.type;
+    this->tracked = false;
+    __cv_count_data(true);
+}
+
+CV::Data::~Data(){
+    if(this->tracked){
+        __cv_gc_forget(this);
+    }
+    __cv_count_data(false);
 }
 
 //
@@ -403,8 +901,8 @@ CV::Data::Data(){
 CV::DataNumber::DataNumber(){
     this->type = CV::DataType::NUMBER;
 }
-std::shared_ptr<CV::Data> CV::DataNumber::unwrap(){
-    return shared_from_this();
+CV::Ref<CV::Data> CV::DataNumber::unwrap(){
+    return CV::Ref<CV::Data>(this);
 }
 
 //
@@ -413,8 +911,8 @@ std::shared_ptr<CV::Data> CV::DataNumber::unwrap(){
 CV::DataString::DataString(){
     this->type = CV::DataType::STRING;
 }
-std::shared_ptr<CV::Data> CV::DataString::unwrap(){
-    return shared_from_this();
+CV::Ref<CV::Data> CV::DataString::unwrap(){
+    return CV::Ref<CV::Data>(this);
 }
 
 //
@@ -423,8 +921,8 @@ std::shared_ptr<CV::Data> CV::DataString::unwrap(){
 CV::DataList::DataList(){
     this->type = CV::DataType::LIST;
 }
-std::shared_ptr<CV::Data> CV::DataList::unwrap(){
-    return shared_from_this();
+CV::Ref<CV::Data> CV::DataList::unwrap(){
+    return CV::Ref<CV::Data>(this);
 }
 
 //
@@ -433,8 +931,29 @@ std::shared_ptr<CV::Data> CV::DataList::unwrap(){
 CV::DataStore::DataStore(){
     this->type = CV::DataType::STORE;
 }
-std::shared_ptr<CV::Data> CV::DataStore::unwrap(){
-    return shared_from_this();
+CV::Ref<CV::Data> CV::DataStore::unwrap(){
+    return CV::Ref<CV::Data>(this);
+}
+
+bool CV::DataStore::has(const std::string &name){
+    return this->v.count(name) > 0;
+}
+
+CV::Ref<CV::Data> CV::DataStore::get(const std::string &name){
+    if(this->v.count(name) == 0){
+        return nullptr;
+    }
+    return this->v[name];
+}
+
+void CV::DataStore::set(const std::string &name, const CV::Ref<CV::Data> &value){
+    this->v.set(name, value);
+    if(!this->tracked && __cv_gc_container(value.get())){
+        // Held by nothing but whoever is filling it in, nothing in 'value' reaches back to it yet
+        if(this->count() > 1){
+            __cv_gc_watch(CV::Ref<CV::Data>(this));
+        }
+    }
 }
 
 //
@@ -444,9 +963,18 @@ CV::DataFunction::DataFunction(){
     this->type = CV::DataType::FUNCTION;
     this->isVariadic = false;
     this->isLambda = false;
+    this->entry = 0;
+    this->kernel = NULL;
 }
-std::shared_ptr<CV::Data> CV::DataFunction::unwrap(){
-    return shared_from_this();
+CV::Ref<CV::Data> CV::DataFunction::unwrap(){
+    return CV::Ref<CV::Data>(this);
+}
+
+void CV::DataFunction::plan(){
+    this->paramIndex.clear();
+    for(int i = 0; i < static_cast<int>(this->params.size()); ++i){
+        this->paramIndex[this->params[i]] = i;
+    }
 }
 
 //
@@ -455,2106 +983,4720 @@ std::shared_ptr<CV::Data> CV::DataFunction::unwrap(){
 CV::DataProxy::DataProxy(){
     this->type = CV::DataType::PROXY;
     this->ptype = CV::Prefixer::NAMER;
+    this->pname = 0;
 }
 
-std::shared_ptr<CV::Data> CV::DataProxy::unwrap(){
-    return this->target ? this->target : shared_from_this();
+CV::Ref<CV::Data> CV::DataProxy::unwrap(){
+    return this->target ? this->target : CV::Ref<CV::Data>(this);
 }
 
 //
-// CONTEXT
+// VALUE POOLS
 //
-CV::Context::Context(){
-    this->head = NULL;
-    this->type = CV::DataType::CONTEXT;
-}
+/*
+    Values rarely outlive the expression that built them (temporaries, arguments, proxies, scopes), so their memory
+    is recycled instead of going back to malloc. Anything counted (values, chunks, contexts, tokens built on their
+    own...) gets its chunk through CV::Counted's operator new, and it goes back to the free list for its 16 byte
+    size class owned by the thread releasing it. A thread's lists are
+    emptied when it exits, anything released after that (statics going away at exit) goes straight to delete.
+    CV_SYSTEM_ALLOCATOR (set by CV_ENABLE_SANITIZERS) skips all of it so ASan sees every value
+*/
+#ifndef CV_SYSTEM_ALLOCATOR
+static const std::size_t CV_POOL_GRAIN = 16;
+static const std::size_t CV_POOL_CLASSES = 16;
+
+struct __cv_pool_chunk {
+    __cv_pool_chunk *next;
+};
 
-std::shared_ptr<CV::Context> CV::Context::buildContext(bool inherit){
-    auto nctx = std::make_shared<CV::Context>();
-    if(inherit){
-        nctx->head = shared_from_this(); 
+struct __cv_pool_lists {
+    __cv_pool_chunk *free[CV_POOL_CLASSES];
+    bool closed;
+};
+
+// Trivially destructible, usable until the thread is gone
+static thread_local __cv_pool_lists __cv_pools = {};
+
+struct __cv_pool_reaper {
+    bool live = true;
+    ~__cv_pool_reaper(){
+        for(std::size_t i = 0; i < CV_POOL_CLASSES; ++i){
+            while(__cv_pools.free[i]){
+                auto next = __cv_pools.free[i]->next;
+                ::operator delete(__cv_pools.free[i]);
+                __cv_pools.free[i] = next;
+            }
+        }
+        __cv_pools.closed = true;
     }
-    return nctx;
-}
+};
+static thread_local __cv_pool_reaper __cv_pool_reaping;
 
-typedef std::pair<std::shared_ptr<CV::Context>, std::shared_ptr<CV::Data>> NamedV;
-std::pair<std::shared_ptr<CV::Context>, std::shared_ptr<CV::Data>> CV::Context::getNamed(const std::string &name){
-    auto lCount = this->data.count(name);
-    return lCount == 0 && head ? head->getNamed(name) : (lCount == 1 ? (NamedV{ shared_from_this(), this->data[name] }) : (NamedV{NULL, NULL}) );
+static void *__cv_pool_take(std::size_t size){
+    std::size_t c = (size - 1) / CV_POOL_GRAIN;
+    if(c >= CV_POOL_CLASSES){
+        return ::operator new(size);
+    }
+    // Always the whole class: whichever thread gives it back may keep it on its list, closed or not here
+    auto chunk = __cv_pools.closed || !__cv_pool_reaping.live ? nullptr : __cv_pools.free[c];
+    if(!chunk){
+        return ::operator new((c + 1) * CV_POOL_GRAIN);
+    }
+    __cv_pools.free[c] = chunk->next;
+    return chunk;
 }
 
-std::shared_ptr<CV::Data> CV::Context::buildNil(){
-    return std::make_shared<CV::Data>();
+static void __cv_pool_give(void *p, std::size_t size){
+    std::size_t c = (size - 1) / CV_POOL_GRAIN;
+    if(c >= CV_POOL_CLASSES || __cv_pools.closed){
+        ::operator delete(p);
+        return;
+    }
+    auto chunk = static_cast<__cv_pool_chunk*>(p);
+    chunk->next = __cv_pools.free[c];
+    __cv_pools.free[c] = chunk;
 }
+#endif
 
-std::shared_ptr<CV::DataNumber> CV::Context::buildNumber(CV_NUMBER v){
-    auto b = std::make_shared<CV::DataNumber>();
-    b->v = v;
-    return b;
+void *CV::Counted::operator new(std::size_t size){
+#ifdef CV_SYSTEM_ALLOCATOR
+    return ::operator new(size);
+#else
+    return __cv_pool_take(size);
+#endif
 }
 
-std::shared_ptr<CV::DataString> CV::Context::buildString(const std::string &v){
-    auto b = std::make_shared<CV::DataString>();
-    b->v = v;
-    return b;
+void CV::Counted::operator delete(void *p, std::size_t size){
+#ifdef CV_SYSTEM_ALLOCATOR
+    (void)size;
+    ::operator delete(p);
+#else
+    __cv_pool_give(p, size);
+#endif
 }
 
-std::shared_ptr<CV::DataList> CV::Context:: buildList(){
-    return std::make_shared<CV::DataList>();
+void CV::Counted::retainShared() const {
+    if(!(refs.load(std::memory_order_relaxed) & IMMORTAL)){
+        refs.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
-std::shared_ptr<CV::DataStore> CV::Context::buildStore(){
-    return std::make_shared<CV::DataStore>();
+static void __cv_release_kept(const CV::Counted *p);
+
+void CV::Counted::releaseLast() const {
+    auto n = refs.load(std::memory_order_relaxed);
+    if(n < IMMORTAL){
+        destroy();
+    }else
+    if(n & KEPT){
+        __cv_release_kept(this);
+    }else
+    if(!(n & IMMORTAL) && refs.fetch_sub(1, std::memory_order_acq_rel) == (SHARED | 1)){
+        destroy();
+    }
 }
 
-std::shared_ptr<CV::Data> CV::Context::unwrap(){
-    return shared_from_this();
+/*
+    Objects a std::shared_ptr from outside owns (a native module's std::make_shared) along with that
+    std::shared_ptr, for as long as Refs hold them. Their counts only change with the mutex held once they get down
+    to the last reference, so a Ref made from another copy of the same std::shared_ptr meanwhile finds it still kept
+*/
+struct __cv_kept_objects {
+    std::mutex mutex;
+    std::unordered_map<const CV::Counted*, std::shared_ptr<const void>> owners;
+};
+
+// Never destroyed, Refs going away during exit may still let go of theirs
+static __cv_kept_objects &__cv_kept(){
+    static auto kept = new __cv_kept_objects();
+    return *kept;
 }
 
-void CV::Context::registerFunction(
-    const std::string &name,
-    const std::vector<std::string> &params,
-    const std::function<std::shared_ptr<CV::Data>(
-        const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-        const std::shared_ptr<CV::Context> &ctx,
-        const std::shared_ptr<CV::Cursor> &cursor,
-        const std::shared_ptr<CV::Token> &token
-    )> &lambda
-){
-    if(!CV::Tools::isValidVarName(name)){
-        return;
+void CV::RefKeep(const CV::Counted *p, std::shared_ptr<const void> owner){
+    auto &kept = __cv_kept();
+    std::lock_guard<std::mutex> lock(kept.mutex);
+    if(kept.owners.emplace(p, std::move(owner)).second){
+        p->refs.fetch_or(CV::Counted::SHARED | CV::Counted::KEPT, std::memory_order_relaxed);
     }
+    p->refs.fetch_add(1, std::memory_order_relaxed);
+}
 
-    if(CV::Tools::isReservedWord(name)){
-        return;
+static void __cv_release_kept(const CV::Counted *p){
+    std::shared_ptr<const void> owner;
+    {
+        auto &kept = __cv_kept();
+        std::lock_guard<std::mutex> lock(kept.mutex);
+        if(p->refs.fetch_sub(1, std::memory_order_acq_rel) != (CV::Counted::SHARED | CV::Counted::KEPT | 1)){
+            return;
+        }
+        p->refs.fetch_and(~(CV::Counted::SHARED | CV::Counted::KEPT), std::memory_order_relaxed);
+        auto it = kept.owners.find(p);
+        owner = std::move(it->second);
+        kept.owners.erase(it);
     }
+    // May destroy the object, done without the mutex held: whatever it holds can be kept too
+}
 
-    auto fn = std::make_shared<CV::DataFunction>();
-    fn->isLambda = true;
-    fn->isVariadic = false;
-    fn->params = params;
-    fn->lambda = lambda;
+//
+// CONSTANTS
+//
+/*
+    nil and the 0/1 conditionals answer with are shared instead of built every time, by every thread: they're
+    immortal, so nobody counts them. Nil can't be changed in place, the numbers are kept safe by never letting a
+    name or a list hold them (they get a copy of their own) and by having every in-place mutation go through
+    __cv_unshared first
+*/
+static CV::Ref<CV::Data> __cv_build_constant(){
+    auto b = CV::MakeRef<CV::Data>();
+    b->immortalize();
+    return b;
+}
 
-    this->data[name] = fn;
+static CV::Ref<CV::DataNumber> __cv_build_constant(CV_NUMBER v){
+    auto b = CV::MakeRef<CV::DataNumber>();
+    b->v = v;
+    b->immortalize();
+    return b;
 }
 
-void CV::Context::registerFunction(
-    const std::string &name,
-    const std::function<std::shared_ptr<CV::Data>(
-        const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-        const std::shared_ptr<CV::Context> &ctx,
-        const std::shared_ptr<CV::Cursor> &cursor,
-        const std::shared_ptr<CV::Token> &token
-    )> &lambda
-){
-    if(!CV::Tools::isValidVarName(name)){
-        return;
-    }
+static const CV::Ref<CV::Data> __cv_nil = __cv_build_constant();
+static const CV::Ref<CV::Data> __cv_zero = __cv_build_constant(0);
+static const CV::Ref<CV::Data> __cv_one = __cv_build_constant(1);
 
-    if(CV::Tools::isReservedWord(name)){
-        return;
-    }
+static bool __cv_is_constant(const CV::Data *d){
+    return d == __cv_zero.get() || d == __cv_one.get();
+}
 
-    auto fn = std::make_shared<CV::DataFunction>();
-    fn->isLambda = true;
-    fn->isVariadic = true;
-    fn->lambda = lambda;
+static const CV::Ref<CV::Data> &__cv_bool_number(bool v){
+    return v ? __cv_one : __cv_zero;
+}
 
-    this->data[name] = fn;
+CV::Ref<CV::Data> CV::Data::unwrap(){
+    return __cv_nil;
+}
+
+// 'subject' itself, or a copy of it if it's a shared constant
+static CV::Ref<CV::Data> __cv_unshared(const CV::Ref<CV::Data> &subject){
+    if(__cv_is_constant(subject.get())){
+        auto b = CV::MakeRef<CV::DataNumber>();
+        b->v = static_cast<CV::DataNumber*>(subject.get())->v;
+        return b;
+    }
+    return subject;
 }
 
-//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //
-//  PARSING
-// 
-//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// LIST ITEMS
+//
+static CV::Ref<CV::Data> __cv_copy(const CV::Ref<CV::Data> &target);
 
-CV::Token::Token(){
-    solved = false;
-    complex = false;
+CV::ListChunk::ListChunk(){
+    this->exposed = true;
 }
 
-CV::Token::Token(const std::string &first, unsigned line){
-    this->first = first;
-    this->line = line;
-    refresh();
-}    
-
-std::shared_ptr<CV::Token> CV::Token::emptyCopy(){
-    auto c = std::make_shared<CV::Token>();
-    c->first = this->first;
-    c->line = this->line;
-    c->refresh();
-    return c;
-}
-std::shared_ptr<CV::Token> CV::Token::copy(){
-    auto c = std::make_shared<CV::Token>();
-    c->first = this->first;
-    c->line = this->line;
-    c->inner = this->inner;
-    c->refresh();
-    return c;
+// A chunk of this list's own with the same items as 'from', copied
+static CV::Ref<CV::ListChunk> __cv_copy_chunk(const CV::ListChunk &from){
+    auto chunk = CV::MakeRef<CV::ListChunk>();
+    for(std::size_t i = 0; i < CV::ListChunk::SIZE; ++i){
+        chunk->items[i] = __cv_copy(from.items[i]);
+    }
+    chunk->exposed = false;
+    return chunk;
 }
 
-std::string CV::Token::str() const {
-    auto f = this->first;
-    std::string out = f + (this->first.size() > 0 && this->inner.size() > 0  ? " " : "");
-    for(int i = 0; i < this->inner.size(); ++i){
-        out += inner[i]->inner.size() == 0 ? inner[i]->first : inner[i]->str();
-        if(i < this->inner.size()-1){
-            out += " ";
+static bool __cv_exposed(const CV::Ref<CV::Data> &item);
+static bool __cv_store_exposed(CV::StoreItems &items);
+
+// Whether any item of 'chunk' is held from anywhere else, checked again only if it could be. Shared ones always are
+static bool __cv_chunk_exposed(CV::ListChunk &chunk){
+    if(!chunk.exposed){
+        return false;
+    }
+    if(chunk.shared()){
+        return true;
+    }
+    for(auto &item : chunk.items){
+        if(__cv_exposed(item)){
+            return true;
         }
     }
-    return this->inner.size() > 0 ? "[" + out + "]" : out;
+    chunk.exposed = false;
+    return false;
 }
 
-void CV::Token::refresh(){
-    complex = this->inner.size() > 0;
-    solved = !(first.length() >= 3 && first[0] == '[' && first[first.size()-1] == ']');
-}
-
-static std::vector<CV::TokenType> ParseTokens(std::string input, char sep, const std::shared_ptr<CV::Cursor> &cursor, int startLine){
-    std::vector<std::shared_ptr<CV::Token>> tokens; 
-    std::string buffer;
-    int open = 0;
-    bool onString = false;
-    bool onComment = false;
-    int leftBrackets = 0;
-    int rightBrackets = 0;
-    int cline = startLine;
-    int quotes = 0;
-    // Count outer brackets
-    for(int i = 0; i < input.size(); ++i){
-        char c = input[i];
-        if(c == '\n'){
-            ++cline;
-        }else
-        if(c == '\\' && i < input.size()-1 && input[i+1] == '\''){
-            i += 1;
-        }else
-        if(c == '\''){
-            onString = !onString;
-            if(onString){
-                ++quotes;
-            }else{
-                --quotes;
-            }
-        }else
-        if(c == '[' && !onString){
-            if(open == 0) ++leftBrackets;
-            ++open;
-        }else
-        if(c == ']' && !onString){
-            if(open == 1) ++rightBrackets;
-            --open;
-        }
-    }
-    onString = false;
-    open = 0;
-    // Throw mismatching brackets
-    if(leftBrackets != rightBrackets){
-        cursor->setError("Syntax Error", "Mismatching brackets", cline+1);
-        return {};
-    }
-    // Throw mismatching quotes
-    if(quotes != 0){
-        cursor->setError("Syntax Error", "Mismatching quotes", cline);
-        return {};
+// Whether 'item', or anything in it, is held from anywhere else. A nested list or store is copied only when handed
+// out, long after 'cc', so an item of it somebody kept would show its later changes through the copy
+static bool __cv_exposed(const CV::Ref<CV::Data> &item){
+    if(item->type == CV::DataType::NIL){
+        return false;
     }
-    cline = startLine;
-    // Add missing brackets for simple statements
-    if(((leftBrackets+rightBrackets)/2 > 1) || (leftBrackets+rightBrackets) == 0 || input[0] != '[' || input[input.length()-1] != ']'){
-        input = "[" + input + "]";
+    if(item.use_count() > 1){
+        return true;
     }
-    // For debugging:
-    // std::cout << "To Parse '" << input << "' " << leftBrackets+rightBrackets << std::endl;
-    // Parse
-    
-    for(int i = 0; i < input.size(); ++i){
-        char c = input[i];
-        if(i < input.size()-1 && c == '\\' && input[i+1] == '\'' && onString){
-            buffer += '\\';
-            buffer += '\'';
-            i += 1;
-            continue;
-        }else      
-        if(c == '\'' && !onComment){
-            onString = !onString;
-            buffer += c;
-        }else        
-        if(c == '#' && !onString){
-            onComment = true;
-            continue;
-        }else
-        if(i < input.size()-1 && c == '\\' && input[i+1] == 'n' && onString){
-            buffer += '\n';
-            ++i;
-            continue;
-        }else            
-        if(c == '\t'){
-            buffer +=  ' ';
-        }else
-        if(c == '\n' && !onString){
-            ++cline;
-            onComment = false;
-            continue;
-        }else
-        if(onComment){
-            continue;
-        }else
-        if(c == '[' && !onString){
-            if(open > 0){
-                buffer += c;
-            }
-            ++open;
-        }else
-        if(c == ']' && !onString){
-            if(open > 1){
-                buffer += c;
-            }            
-            --open;
-            if(open == 1 || i == input.size()-1 && buffer.length() > 0){
-                if(buffer != ""){
-                    tokens.push_back(std::make_shared<CV::Token>(buffer, cline));
-                }
-                buffer = "";
-            }
-        }else
-        if(i == input.size()-1){
-            if(buffer != ""){
-                tokens.push_back(std::make_shared<CV::Token>(buffer+c, cline));
+    if(item->type == CV::DataType::LIST){
+        auto &items = static_cast<CV::DataList*>(item.get())->v;
+        for(auto &chunk : items.chunks){
+            if(__cv_chunk_exposed(*chunk)){
+                return true;
             }
-            buffer = "";
-        }else
-        if(c == sep && open == 1 && !onString){
-            if(buffer != ""){
-                tokens.push_back(std::make_shared<CV::Token>(buffer, cline));
+        }
+        for(auto &inner : items.tail){
+            if(__cv_exposed(inner)){
+                return true;
             }
-            buffer = "";
-        }else{
-            buffer += c;
+        }
+    }else
+    if(item->type == CV::DataType::STORE){
+        if(__cv_store_exposed(static_cast<CV::DataStore*>(item.get())->v)){
+            return true;
         }
     }
+    return false;
+}
 
-    return tokens;
-};
+const CV::Ref<CV::Data> &CV::ListItems::operator[](std::size_t i) const {
+    std::size_t inChunks = this->chunks.size() * CV::ListChunk::SIZE;
+    if(i >= inChunks){
+        return this->tail[i - inChunks];
+    }
+    return this->chunks[i / CV::ListChunk::SIZE]->items[i % CV::ListChunk::SIZE];
+}
 
-static std::vector<CV::TokenType> RebuildTokenHierarchy(const std::vector<CV::TokenType> &input, char sep, const CV::CursorType &cursor){
-    
-    if(input.size() == 0){
-        cursor->setError("NOOP", CV_ERROR_MSG_NOOP_NO_INSTRUCTIONS, 1);
-        return {};
+const CV::Ref<CV::Data> &CV::ListItems::operator[](std::size_t i){
+    std::size_t inChunks = this->chunks.size() * CV::ListChunk::SIZE;
+    if(i >= inChunks){
+        return this->tail[i - inChunks];
+    }
+    auto &chunk = this->chunks[i / CV::ListChunk::SIZE];
+    if(chunk.use_count() > 1){
+        chunk = __cv_copy_chunk(*chunk);
     }
+    chunk->exposed = true;
+    return chunk->items[i % CV::ListChunk::SIZE];
+}
 
-    std::function<CV::TokenType(const CV::TokenType &token)> unwrap = [&](const CV::TokenType &token){
-        auto innerTokens = ParseTokens(token->first, sep, cursor, token->line);
-        if(cursor->error){
-            return CV::TokenType(NULL);
+const CV::Ref<CV::Data> &CV::ListItems::back(){
+    if(this->tail.empty()){
+        // Bring the last chunk back as the tail, it's this list's own from then on
+        auto chunk = this->chunks.back();
+        this->chunks.pop_back();
+        if(chunk.use_count() > 1){
+            chunk = __cv_copy_chunk(*chunk);
         }
+        this->tail.assign(
+            std::make_move_iterator(std::begin(chunk->items)),
+            std::make_move_iterator(std::end(chunk->items))
+        );
+    }
+    return this->tail.back();
+}
 
-        if(innerTokens.size() == 0){
-            auto empty = token->copy();
-            empty->first = "";
-            empty->inner.clear();
-            empty->refresh();
-            return empty;
-        }
-        auto target = innerTokens[0];
+void CV::ListItems::push_back(const CV::Ref<CV::Data> &item){
+    this->tail.push_back(item);
+    if(this->tail.size() == CV::ListChunk::SIZE){
+        auto chunk = CV::MakeRef<CV::ListChunk>();
+        std::move(this->tail.begin(), this->tail.end(), std::begin(chunk->items));
+        this->chunks.push_back(std::move(chunk));
+        this->tail.clear();
+    }
+}
 
-        if(!target->solved){
-            target->inner.push_back(unwrap(target));
-            target->first = "";
-            if(cursor->error){
-                return CV::TokenType(NULL);
-            }
-        }
-        for(int i = 1; i < innerTokens.size(); ++i){
-            target->inner.push_back(unwrap(innerTokens[i]));
-        }
-        target->refresh();
-        return target;
-    };
+void CV::ListItems::pop_back(){
+    this->back();
+    this->tail.pop_back();
+}
 
-    std::vector<CV::TokenType> result;
-    
-    for(int i = 0; i < input.size(); ++i){
-        auto built = unwrap(input[i]);
-        if(cursor->error){
-            return {};
-        }
-        result.push_back(built);
-    }
+void CV::ListItems::clear(){
+    this->chunks.clear();
+    this->tail.clear();
+}
 
+CV::ListItems CV::ListItems::copy() const {
+    CV::ListItems result;
+    result.chunks.reserve(this->chunks.size());
+    for(auto &chunk : this->chunks){
+        result.chunks.push_back(__cv_chunk_exposed(*chunk) ? __cv_copy_chunk(*chunk) : chunk);
+    }
+    result.tail.reserve(this->tail.size());
+    for(auto &item : this->tail){
+        result.tail.push_back(__cv_copy(item));
+    }
     return result;
 }
 
-std::vector<CV::TokenType> CV::BuildTree(
-    const std::string &input,
-    const CV::CursorType &cursor
-){
-    if(input.size() == 0){
-        cursor->setError("Syntax Error", "Empty input", 1);
-        return {};
+//
+// STORE ITEMS
+//
+// Whether any member of its own is held from anywhere else, checked again only if it could be. Shared ones never are
+static bool __cv_store_exposed(CV::StoreItems &items){
+    if(!items.exposed){
+        return false;
     }
-
-    auto isBracketedToken = [](const CV::TokenType &token) -> bool {
-        if(!token){
-            return false;
+    for(auto &it : items.own){
+        if(__cv_exposed(it.second)){
+            return true;
         }
-        auto s = CV::Tools::cleanTokenInput(token->first);
-        return s.size() >= 2 && s.front() == '[' && s.back() == ']';
-    };
+    }
+    items.exposed = false;
+    return false;
+}
 
-    auto isNamerAssignmentToken = [](const CV::TokenType &token) -> bool {
-        if(!token){
-            return false;
+// The last store holding what was shared takes it back, what it has of its own still hiding the shared ones
+static void __cv_store_reclaim(CV::StoreItems &items){
+    if(items.own.empty()){
+        items.own.swap(items.shared->items);
+    }else{
+        for(auto &it : items.shared->items){
+            items.own.try_emplace(it.first, std::move(it.second));
         }
-        return token->first.size() >= 2 &&
-               token->first[0] == '~' &&
-               token->inner.size() == 1;
-    };
+    }
+    items.shared = nullptr;
+    items.added = 0;
+}
 
-    auto needsProgramWrap = [&](const std::string &src) -> bool {
-        auto top = ParseTokens(src, ' ', cursor, 1);
-        if(cursor->error){
-            return false;
-        }
+CV::StoreItems::StoreItems(){
+    this->added = 0;
+    this->exposed = true;
+}
 
-        if(top.empty()){
-            return false;
-        }
+std::size_t CV::StoreItems::count(const std::string &name) const {
+    return this->own.count(name) > 0 || (this->shared && this->shared->items.count(name) > 0) ? 1 : 0;
+}
 
-        bool allBracketed = true;
-        for(const auto &t : top){
-            if(!isBracketedToken(t)){
-                allBracketed = false;
-                break;
-            }
-        }
+const CV::Ref<CV::Data> &CV::StoreItems::member(const std::string &name){
+    this->exposed = true;
+    if(this->shared && this->shared.use_count() == 1){
+        __cv_store_reclaim(*this);
+    }
+    if(!this->shared){
+        return this->own[name];
+    }
+    auto it = this->own.find(name);
+    if(it != this->own.end()){
+        return it->second;
+    }
+    auto from = this->shared->items.find(name);
+    auto &item = this->own[name];
+    if(from != this->shared->items.end()){
+        item = __cv_copy(from->second);
+    }else{
+        ++this->added;
+    }
+    return item;
+}
 
-        if(!allBracketed){
-            return true;
-        }
+void CV::StoreItems::set(const std::string &name, const CV::Ref<CV::Data> &value){
+    this->exposed = true;
+    if(this->shared && this->shared.use_count() == 1){
+        __cv_store_reclaim(*this);
+    }
+    if(this->own.insert_or_assign(name, value).second && this->shared && this->shared->items.count(name) == 0){
+        ++this->added;
+    }
+}
 
-        std::vector<CV::TokenType> rebuilt;
-        for(int i = 0; i < static_cast<int>(top.size()); ++i){
-            auto built = RebuildTokenHierarchy({top[i]}, ' ', cursor);
-            if(cursor->error){
-                return false;
-            }
-            for(int j = 0; j < static_cast<int>(built.size()); ++j){
-                rebuilt.push_back(built[j]);
+CV::StoreItems::Map &CV::StoreItems::owned(){
+    this->exposed = true;
+    if(this->shared && this->shared.use_count() == 1){
+        __cv_store_reclaim(*this);
+    }
+    if(this->shared){
+        for(auto &it : this->shared->items){
+            if(this->own.count(it.first) == 0){
+                this->own.emplace(it.first, __cv_copy(it.second));
             }
         }
+        this->shared = nullptr;
+        this->added = 0;
+    }
+    return this->own;
+}
 
-        bool allNamerAssignments = !rebuilt.empty();
-        for(const auto &t : rebuilt){
-            if(!isNamerAssignmentToken(t)){
-                allNamerAssignments = false;
-                break;
+void CV::StoreItems::clear(){
+    this->own.clear();
+    this->shared = nullptr;
+    this->added = 0;
+}
+
+CV::StoreItems CV::StoreItems::copy(){
+    CV::StoreItems result;
+    if(!this->shared){
+        if(__cv_store_exposed(*this)){
+            result.own.reserve(this->own.size());
+            for(auto &it : this->own){
+                result.own.emplace(it.first, __cv_copy(it.second));
             }
+            return result;
         }
+        this->shared = CV::MakeRef<CV::StoreMembers>();
+        this->shared->items.swap(this->own);
+    }
+    // Whatever is shared stays so, only what this store has of its own gets copied
+    result.shared = this->shared;
+    for(auto &it : this->own){
+        result.own.emplace(it.first, __cv_copy(it.second));
+    }
+    result.added = this->added;
+    return result;
+}
 
-        if(allNamerAssignments){
-            return true;
+// Shared members first, each one hidden by the own one of the same name if any, then those only this store has
+void CV::StoreItems::const_iterator::settle(){
+    auto &own = this->items->own;
+    if(!this->inOwn){
+        auto &shared = this->items->shared->items;
+        if(this->it != shared.end()){
+            auto over = own.empty() ? own.end() : own.find(this->it->first);
+            this->current = over != own.end() ? &*over : &*this->it;
+            return;
         }
+        this->inOwn = true;
+        this->it = own.begin();
+    }
+    if(this->items->shared){
+        while(this->it != own.end() && this->items->shared->items.count(this->it->first) > 0){
+            ++this->it;
+        }
+    }
+    this->current = this->it != own.end() ? &*this->it : nullptr;
+}
 
-        return false;
-    };
+CV::StoreItems::const_iterator &CV::StoreItems::const_iterator::operator++(){
+    ++this->it;
+    this->settle();
+    return *this;
+}
 
-    auto cleanInput = CV::Tools::cleanTokenInput(input);
-    if(cleanInput.empty()){
-        cursor->setError("Syntax Error", "Empty input", 1);
-        return {};
-    }
+CV::StoreItems::const_iterator CV::StoreItems::begin() const {
+    const_iterator result = this->shared ?
+        const_iterator{this, this->shared->items.begin(), false, nullptr} :
+        const_iterator{this, this->own.begin(), true, nullptr};
+    result.settle();
+    return result;
+}
 
-    std::string fixedInput = input;
+CV::StoreItems::const_iterator CV::StoreItems::end() const {
+    return {this, this->own.end(), true, nullptr};
+}
 
-    if(cleanInput.front() != '[' || cleanInput.back() != ']'){
-        fixedInput = "[" + fixedInput;
-        if(!fixedInput.empty() && fixedInput.back() == '\n'){
-            fixedInput.back() = ']';
-        }else{
-            fixedInput += "]";
+CV::StoreItems::const_iterator CV::StoreItems::find(const std::string &name) const {
+    if(this->shared){
+        auto it = this->shared->items.find(name);
+        if(it != this->shared->items.end()){
+            const_iterator result = {this, it, false, nullptr};
+            result.settle();
+            return result;
         }
     }
+    auto it = this->own.find(name);
+    return {this, it, true, it != this->own.end() ? &*it : nullptr};
+}
 
-    cleanInput = CV::Tools::cleanTokenInput(fixedInput);
-    if(cleanInput.empty()){
-        cursor->setError("Syntax Error", "Empty input", 1);
-        return {};
-    }
+//
+// VALUE
+//
+CV::Value::Value(){
+    this->type = CV::DataType::NIL;
+    this->number = 0;
+}
 
-    if(needsProgramWrap(cleanInput)){
-        fixedInput = "[" + fixedInput + "]";
-    }
+CV::Value::Value(CV_NUMBER number){
+    this->type = CV::DataType::NUMBER;
+    this->number = number;
+}
 
-    auto tokens = ParseTokens(fixedInput, ' ', cursor, 1);
-    if(cursor->error){
-        return {};
-    }
+CV::Value::Value(const CV::Ref<CV::Data> &ref){
+    this->type = ref ? ref->type : CV::DataType::NIL;
+    this->number = 0;
+    this->ref = ref;
+}
 
-    std::vector<CV::TokenType> root;
+CV::Value::Value(CV::Ref<CV::Data> &&ref){
+    this->type = ref ? ref->type : CV::DataType::NIL;
+    this->number = 0;
+    this->ref = std::move(ref);
+}
 
-    for(int i = 0; i < static_cast<int>(tokens.size()); ++i){
-        auto built = RebuildTokenHierarchy({tokens[i]}, ' ', cursor);
-        if(cursor->error){
-            return {};
-        }
+bool CV::Value::isImmediate() const {
+    return !this->ref;
+}
 
-        for(int j = 0; j < static_cast<int>(built.size()); ++j){
-            root.push_back(built[j]);
-        }
+CV_NUMBER CV::Value::toNumber() const {
+    return this->ref ? static_cast<CV::DataNumber*>(this->ref.get())->v : this->number;
+}
+
+CV::Ref<CV::Data> CV::Value::box() const {
+    if(this->ref){
+        return this->ref;
     }
-    if(root.size() > 1){
-        bool allTopLevelNamerAssignments = true;
+    if(this->type == CV::DataType::NUMBER){
+        auto b = CV::MakeRef<CV::DataNumber>();
+        b->v = this->number;
+        return b;
+    }
+    return __cv_nil;
+}
 
-        for(const auto &t : root){
-            if(!isNamerAssignmentToken(t)){
-                allTopLevelNamerAssignments = false;
-                break;
-            }
-        }
+//
+// CONTEXT
+//
+static void __cv_forget_module_results(uint64_t context);
 
-        if(allTopLevelNamerAssignments){
-            auto grouped = std::make_shared<CV::Token>("", root[0]->line);
-            grouped->first = "";
-            grouped->inner = root;
-            grouped->solved = true;
-            grouped->refresh();
+CV::Context::Context(){
+    this->head = NULL;
+    this->data.owner = this;
+    this->type = CV::DataType::CONTEXT;
+    this->id = __cv_context_serial.fetch_add(1, std::memory_order_relaxed) + 1;
+    this->frozen.store(false, std::memory_order_relaxed);
+    this->isFork = false;
+    this->seen = false;
+    this->imported = false;
+}
 
-            root.clear();
-            root.push_back(grouped);
-        }
-    }    
+CV::Context::~Context(){
+    if(this->imported){
+        __cv_forget_module_results(this->id);
+    }
+}
 
-    if(root.empty()){
-        return {};
+const CV::Ref<CV::Data> &CV::Context::setNamed(CV::Symbol name, const CV::Ref<CV::Data> &value){
+    // Rebinding keeps the slot caches point at. A context no cache walked through can't be part of what any cache saw
+    auto it = this->data.find(name);
+    if(it != this->data.end()){
+        it->second = __cv_unshared(value);
+        return it->second;
     }
+    if(this->seen || this->frozen.load(std::memory_order_relaxed)){
+        __cv_names_version.fetch_add(1, std::memory_order_relaxed);
+    }
+    return this->data.emplace(name, __cv_unshared(value)).first->second;
+}
 
-    return root;
+const CV::Ref<CV::Data> &CV::Context::setNamed(const std::string &name, const CV::Ref<CV::Data> &value){
+    return this->setNamed(CV::Intern(name), value);
 }
 
-static std::shared_ptr<CV::Data> __cv_run_children(
-    const CV::TokenType &parent,
-    int from,
-    const CV::CursorType &cursor,
-    const CV::ControlFlowType &cf,
-    const CV::ContextType &ctx
-){
-    auto result = ctx->buildNil();
+CV::Ref<CV::Context> CV::Context::buildContext(bool inherit){
+    auto nctx = CV::MakeRef<CV::Context>();
+    if(inherit){
+        nctx->head = CV::Ref<CV::Context>(this);
+    }
+    return nctx;
+}
 
-    for(int i = from; i < static_cast<int>(parent->inner.size()); ++i){
-        result = CV::Interpret(parent->inner[i], cursor, cf, ctx);
-        if(cursor->error){
-            return ctx->buildNil();
-        }
+CV::Ref<CV::Context> CV::Context::fork(){
+    // Whatever the fork can see is frozen, other forks (maybe on other threads) are reading it too
+    for(auto c = this; c && !c->frozen.load(std::memory_order_relaxed); c = c->head.get()){
+        c->frozen.store(true, std::memory_order_relaxed);
+    }
+    auto nctx = this->buildContext(true);
+    nctx->isFork = true;
+    return nctx;
+}
 
-        if(cf->state == CV::ControlFlowState::RETURN ||
-           cf->state == CV::ControlFlowState::YIELD ||
-           cf->state == CV::ControlFlowState::SKIP){
-            return result;
+typedef std::pair<CV::Ref<CV::Context>, CV::Ref<CV::Data>> NamedV;
+std::pair<CV::Ref<CV::Context>, CV::Ref<CV::Data>> CV::Context::getNamed(CV::Symbol name){
+    for(auto c = this; c; c = c->head.get()){
+        auto it = c->data.find(name);
+        if(it != c->data.end()){
+            return NamedV{ CV::Ref<CV::Context>(c), it->second };
         }
     }
-
-    return result;
+    return NamedV{NULL, NULL};
 }
 
-static bool __cv_get_boolean_value(const std::shared_ptr<CV::Data> &target){
-    auto v = target ? target->unwrap() : std::shared_ptr<CV::Data>(nullptr);
-    if(!v){
-        return false;
+std::pair<CV::Ref<CV::Context>, CV::Ref<CV::Data>> CV::Context::getNamed(const std::string &name){
+    CV::Symbol symbol;
+    if(!__cv_find_symbol(name, symbol)){
+        return NamedV{NULL, NULL};
     }
+    return this->getNamed(symbol);
+}
 
-    switch(v->type){
-        case CV::DataType::NIL:
-            return false;
-        case CV::DataType::NUMBER:
-            return std::static_pointer_cast<CV::DataNumber>(v)->v != 0;
-        case CV::DataType::STRING:
-            return !std::static_pointer_cast<CV::DataString>(v)->v.empty();
-        case CV::DataType::LIST:
-            return !std::static_pointer_cast<CV::DataList>(v)->v.empty();
-        case CV::DataType::STORE:
-            return !std::static_pointer_cast<CV::DataStore>(v)->v.empty();
-        default:
-            return true;
+const CV::Ref<CV::Data> &CV::ContextData::Binding::get() const {
+    static const CV::Ref<CV::Data> missing;
+    CV::Symbol symbol;
+    if(!__cv_find_symbol(name, symbol)){
+        return missing;
     }
+    auto it = owner->data.find(symbol);
+    return it == owner->data.end() ? missing : it->second;
 }
 
-static bool __cv_is_iterator_clause(const CV::TokenType &token){
-    return token &&
-           token->first.size() >= 2 &&
-           token->first[0] == '~' &&
-           token->inner.size() == 1;
+CV::ContextData::Binding &CV::ContextData::Binding::operator=(const CV::Ref<CV::Data> &value){
+    owner->setNamed(name, value);
+    return *this;
 }
 
-#if (_CV_PLATFORM == _CV_PLATFORM_TYPE_LINUX) || (_CV_PLATFORM == _CV_PLATFORM_TYPE_OSX)
-    using __cv_dynlib_handle_t = void*;
-#elif (_CV_PLATFORM == _CV_PLATFORM_TYPE_WINDOWS)
-    using __cv_dynlib_handle_t = HMODULE;
-#endif
+CV::ContextData::Binding &CV::ContextData::Binding::operator=(const Binding &other){
+    owner->setNamed(name, other.get());
+    return *this;
+}
 
-static std::mutex __cv_loaded_dynamic_libs_mutex;
-static std::unordered_map<int, std::pair<__cv_dynlib_handle_t, std::string>> __cv_loaded_dynamic_libs;
+std::size_t CV::ContextData::count(const std::string &name) const {
+    CV::Symbol symbol;
+    return __cv_find_symbol(name, symbol) ? Map::count(symbol) : 0;
+}
 
-static std::string __cv_resolve_import_path(
-    const std::string &fname,
-    const std::string &defaultExt
-){
-    std::string resolved = fname;
+CV::Ref<CV::Data> CV::Context::buildNil(){
+    return __cv_nil;
+}
 
-    if(CV::Tools::fileExtension(resolved) == ""){
-        resolved += defaultExt;
-    }
+CV::Ref<CV::DataNumber> CV::Context::buildNumber(CV_NUMBER v){
+    auto b = CV::MakeRef<CV::DataNumber>();
+    b->v = v;
+    return b;
+}
 
-    if(CV::Tools::fileExists("./" + resolved)){
-        resolved = "./" + resolved;
-    }else{
-        resolved = CV_LIB_HOME + "/" + resolved;
-    }
+CV::Ref<CV::DataString> CV::Context::buildString(const std::string &v){
+    auto b = CV::MakeRef<CV::DataString>();
+    b->v = v;
+    return b;
+}
 
-    return resolved;
+CV::Ref<CV::DataList> CV::Context:: buildList(){
+    return CV::MakeRef<CV::DataList>();
 }
 
-std::shared_ptr<CV::Data> CV::Interpret(
-    const CV::TokenType &token,
-    const CV::CursorType &cursor,
-    const CV::ControlFlowType &cf,
-    const CV::ContextType &ctx
+CV::Ref<CV::DataStore> CV::Context::buildStore(){
+    return CV::MakeRef<CV::DataStore>();
+}
+
+CV::Ref<CV::Data> CV::Context::unwrap(){
+    return CV::Ref<CV::Data>(this);
+}
+
+void CV::Context::registerFunction(
+    const std::string &name,
+    const std::vector<std::string> &params,
+    const std::function<CV::Ref<CV::Data>(
+        const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+        const CV::Ref<CV::Context> &ctx,
+        const CV::Ref<CV::Cursor> &cursor,
+        const CV::Ref<CV::Token> &token
+    )> &lambda
 ){
-    if(token->first.size() == 0 && token->inner.size() == 0){
-        cursor->setError("NOOP", CV_ERROR_MSG_NOOP_NO_INSTRUCTIONS, token);
-        return ctx->buildNil();
+    if(!CV::Tools::isValidVarName(name)){
+        return;
     }
 
-    auto bListConstruct = [cursor, cf](const CV::TokenType &origin, std::vector<CV::TokenType> &tokens, const CV::ContextType &ctx){
-        auto list = ctx->buildList();
+    if(CV::Tools::isReservedWord(name)){
+        return;
+    }
 
-        for(int i = 0; i < static_cast<int>(tokens.size()); ++i){
-            auto &inc = tokens[i];
+    auto fn = CV::MakeRef<CV::DataFunction>();
+    fn->isLambda = true;
+    fn->isVariadic = false;
+    for(int i = 0; i < static_cast<int>(params.size()); ++i){
+        fn->params.push_back(CV::Intern(params[i]));
+    }
+    fn->lambda = lambda;
+    fn->plan();
 
-            auto data = Interpret(inc, cursor, cf, ctx);
-            if(cursor->error){
-                cursor->subject = origin;
-                return ctx->buildNil();
-            }
+    this->setNamed(name, fn);
+}
 
-            if(cf->state == CV::ControlFlowState::YIELD){
-                return data;
-            }
+void CV::Context::registerFunction(
+    const std::string &name,
+    const std::function<CV::Ref<CV::Data>(
+        const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+        const CV::Ref<CV::Context> &ctx,
+        const CV::Ref<CV::Cursor> &cursor,
+        const CV::Ref<CV::Token> &token
+    )> &lambda
+){
+    if(!CV::Tools::isValidVarName(name)){
+        return;
+    }
 
-            if(cf->state == CV::ControlFlowState::RETURN ||
-            cf->state == CV::ControlFlowState::SKIP){
-                return data;
-            }
+    if(CV::Tools::isReservedWord(name)){
+        return;
+    }
 
-            if(data && data->type == CV::DataType::PROXY){
-                auto proxy = std::static_pointer_cast<CV::DataProxy>(data);
+    auto fn = CV::MakeRef<CV::DataFunction>();
+    fn->isLambda = true;
+    fn->isVariadic = true;
+    fn->lambda = lambda;
 
-                if(proxy->ptype == CV::Prefixer::EXPANDER){
-                    if(!proxy->target){
-                        cursor->setError(
-                            CV_ERROR_MSG_MISUSED_PREFIX,
-                            "Expander Prefix '^' produced a proxy without target",
-                            inc
-                        );
-                        cursor->subject = origin;
-                        return ctx->buildNil();
-                    }
+    this->setNamed(name, fn);
+}
 
-                    auto expanded = proxy->target->unwrap();
-                    if(!expanded || expanded->type != CV::DataType::LIST){
-                        cursor->setError(
-                            CV_ERROR_MSG_MISUSED_PREFIX,
-                            "Expander Prefix '^' expects target to resolve into a LIST",
-                            inc
-                        );
-                        cursor->subject = origin;
-                        return ctx->buildNil();
-                    }
+// Native modules trade in std::shared_ptr, each value handed over or back goes through CV::Ref's conversions
+static decltype(CV::DataFunction::lambda) __cv_native_lambda(const CV::NativeFunction &lambda){
+    return [lambda](
+        const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+        const CV::Ref<CV::Context> &ctx,
+        const CV::Ref<CV::Cursor> &cursor,
+        const CV::Ref<CV::Token> &token
+    ) -> CV::Ref<CV::Data> {
+        std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> native;
+        native.reserve(args.size());
+        for(auto &arg : args){
+            native.emplace_back(arg.first, arg.second);
+        }
+        return lambda(native, ctx, cursor, token);
+    };
+}
 
-                    auto expandedList = std::static_pointer_cast<CV::DataList>(expanded);
+void CV::Context::registerFunction(const std::string &name, const std::vector<std::string> &params, const CV::NativeFunction &lambda){
+    this->registerFunction(name, params, __cv_native_lambda(lambda));
+}
 
-                    for(int j = 0; j < static_cast<int>(expandedList->v.size()); ++j){
-                        list->v.push_back(expandedList->v[j]);
-                    }
+void CV::Context::registerFunction(const std::string &name, const CV::NativeFunction &lambda){
+    this->registerFunction(name, __cv_native_lambda(lambda));
+}
 
-                    continue;
-                }
-            }
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  PARSING
+// 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-            list->v.push_back(data ? data->unwrap() : ctx->buildNil());
-        }
+CV::Token::Token(){
+    solved = false;
+    complex = false;
+    kind = CV::TokenKind::NAME;
+    opcode = CV::Opcode::NAME;
+    number = 0;
+    namerCheck = CV::NamerCheck::VALID;
+    symbol = 0;
+}
 
-        return std::static_pointer_cast<CV::Data>(list);
-    };
+CV::Token::Token(const std::string &first, unsigned line){
+    this->first = first;
+    this->line = line;
+    refresh();
+}    
 
+CV::Ref<CV::Token> CV::Token::emptyCopy(){
+    auto c = CV::MakeRef<CV::Token>();
+    c->first = this->first;
+    c->line = this->line;
+    c->refresh();
+    return c;
+}
+CV::Ref<CV::Token> CV::Token::copy(){
+    auto c = CV::MakeRef<CV::Token>();
+    c->first = this->first;
+    c->line = this->line;
+    c->inner = this->inner;
+    c->refresh();
+    return c;
+}
 
-    auto bStoreConstruct = [cursor, cf](const std::string &name, const CV::TokenType &origin, std::vector<CV::TokenType> &tokens, const CV::ContextType &ctx){
-        auto store = ctx->buildStore();
-        for(int i = 0; i < tokens.size(); ++i){
-            auto &inc = tokens[i];
-            auto fetched = Interpret(inc, cursor, cf, ctx);
-            if(cursor->error){
-                cursor->subject = origin;
-                return ctx->buildNil();
-            }
-            if(cf->state == CV::ControlFlowState::YIELD){
-                return fetched;
-            }
-            if(fetched->type != CV::DataType::PROXY){
-                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+name+"' may only be able to construct named types using NAMER prefixer", origin);
-                return ctx->buildNil();
-            }
-            auto proxy = std::static_pointer_cast<CV::DataProxy>(fetched);
-            // We eat up the instruction itself as we don't really execute it for this situation
-            if(!proxy->target){
-                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+name+"' expects Namer prefixed tokens to have an appended body so it defines a value", origin);
-                return ctx->buildNil();
-            }
-            
-            auto vname = proxy->pname;
-            if(!CV::Tools::isValidVarName(vname)){
-                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+name+"' is attempting to construct store with invalidly named type '"+vname+"'", origin);
-                return ctx->buildNil();
-            }
-            if(CV::Tools::isReservedWord(vname)){
-                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+name+"' is attempting to construct store with reserved name named type '"+vname+"'", origin);
-                return ctx->buildNil();               
-            }
-            store->v[vname] = proxy->target;
+std::string CV::Token::str() const {
+    auto f = this->first;
+    std::string out = f + (this->first.size() > 0 && this->inner.size() > 0  ? " " : "");
+    for(int i = 0; i < this->inner.size(); ++i){
+        out += inner[i]->inner.size() == 0 ? inner[i]->first : inner[i]->str();
+        if(i < this->inner.size()-1){
+            out += " ";
         }
-        return std::static_pointer_cast<CV::Data>(store);
-    };    
+    }
+    return this->inner.size() > 0 ? "[" + out + "]" : out;
+}
 
-    auto bListConstructFromToken = [bListConstruct, cursor](const CV::TokenType &origin, const CV::ContextType &ctx){
-        auto cpy = origin->emptyCopy();
-        std::vector<CV::TokenType> inners { cpy };
-        for(int i = 0; i < origin->inner.size(); ++i){
-            inners.push_back(origin->inner[i]);
-        }
-        return bListConstruct(origin, inners, ctx);
+static int __cv_resolve_opcode(const std::string &first, int kind){
+    static const std::unordered_map<std::string, int> imperatives {
+        {"b:store", CV::Opcode::B_STORE},
+        {"b:list", CV::Opcode::B_LIST},
+        {"skip", CV::Opcode::SKIP},
+        {"return", CV::Opcode::RETURN},
+        {"yield", CV::Opcode::YIELD},
+        {"fn", CV::Opcode::FN},
+        {"cc", CV::Opcode::CC},
+        {"mut", CV::Opcode::MUT},
+        {"import", CV::Opcode::IMPORT},
+        {"import:dynamic-library", CV::Opcode::IMPORT_DYNAMIC_LIBRARY},
+        {"let", CV::Opcode::LET},
+        {"if", CV::Opcode::IF},
+        {"while", CV::Opcode::WHILE},
+        {"for", CV::Opcode::FOR},
+        {"foreach", CV::Opcode::FOREACH}
     };
 
-    auto isNameFunction = [](const CV::TokenType &token, const CV::ContextType &ctx){
-        if(!token->solved){
-            return false;
-        }
-        if(CV::Tools::isReservedWord(token->first)){
-            return true;
-        }
-        auto dataRef = ctx->getNamed(token->first);
-        if(!dataRef.first || !dataRef.second){
-            return false;
-        }
-        auto data = dataRef.second;
-        if(data->type == CV::DataType::PROXY){
-            data = std::static_pointer_cast<CV::DataProxy>(data)->target;
-        }
-        return data && (data->type == CV::DataType::FUNCTION ||
-                data->type == CV::DataType::STORE);
-    };
-    
-    auto areAllNames = [](const CV::TokenType &token, const CV::ContextType &ctx){
-        (void)ctx;
+    if(first.size() == 0){
+        return CV::Opcode::GROUP;
+    }
 
-        if(token->inner.size() < 1){
-            return false;
-        }
+    auto it = imperatives.find(first);
+    if(it != imperatives.end()){
+        return it->second;
+    }
 
-        for(int i = 0; i < token->inner.size(); ++i){
-            auto &child = token->inner[i];
+    switch(first[0]){
+        case '?': return CV::Opcode::TRY;
+        case '%': return CV::Opcode::TEMPLATE;
+        case '^': return CV::Opcode::EXPANDER;
+        case '~': return CV::Opcode::NAMER;
+    }
 
-            if(child->first.size() < 2 || child->first[0] != '~'){
-                return false;
-            }
+    switch(kind){
+        case CV::TokenKind::NIL: return CV::Opcode::NIL;
+        case CV::TokenKind::NUMBER: return CV::Opcode::NUMBER;
+        case CV::TokenKind::STRING: return CV::Opcode::STRING;
+        default: return CV::Opcode::NAME;
+    }
+}
 
-            if(child->inner.size() == 0){
-                return false;
-            }
-        }
+static int CountStatements(const std::string &input, const CV::CursorType &cursor, int line);
 
-        return true;
-    };
-    
-    auto areAllFunctions = [isNameFunction](const CV::TokenType &token, const CV::ContextType &ctx){
-        if(token->inner.size() < 1){
-            return false;
-        } 
-        
-        for(int i = 0; i < token->inner.size(); ++i){
-            if(token->inner[i]->first.size() == 0 || !isNameFunction(token->inner[i], ctx)){
-                return false;
-            } 
+static int __cv_check_namer(const std::string &name, unsigned line){
+    auto shadowCursor = CV::MakeRef<CV::Cursor>();
+    auto statements = CountStatements(name, shadowCursor, line);
+    if(shadowCursor->error){
+        return CV::NamerCheck::UNSCANNABLE;
+    }
+    if(statements > 1){
+        return CV::NamerCheck::COMPLEX;
+    }
+    if(!CV::Tools::isValidVarName(name)){
+        return CV::NamerCheck::INVALID;
+    }
+    if(CV::Tools::isReservedWord(name)){
+        return CV::NamerCheck::RESERVED;
+    }
+    return CV::NamerCheck::VALID;
+}
+
+void CV::Token::refresh(){
+    complex = this->inner.size() > 0;
+    solved = !(first.length() >= 3 && first[0] == '[' && first[first.size()-1] == ']');
+
+    // Classify once so literals don't need to be parsed every time they're interpreted
+    kind = CV::TokenKind::NAME;
+    number = 0;
+    literal.clear();
+    if(first == "nil"){
+        kind = CV::TokenKind::NIL;
+    }else
+    if(first.size() > 0 && (first[0] == '?' || first[0] == '%' || first[0] == '^' || first[0] == '~')){
+        kind = CV::TokenKind::PREFIXED;
+    }else
+    if(first.size() > 0 && CV::Tools::isNumber(first)){
+        char *end = NULL;
+        number = std::strtod(first.c_str(), &end);
+        // Things like '.' or '-.' look numeric but aren't numbers
+        if(end != first.c_str()){
+            kind = CV::TokenKind::NUMBER;
         }
-        return true;
-    };
+    }else
+    if(CV::Tools::isString(first)){
+        kind = CV::TokenKind::STRING;
+        literal = first.substr(1, first.length() - 2);
+    }
 
-    if(token->first.size() == 0){
-        // Instruction list
-        if(areAllFunctions(token, ctx) && token->inner.size() >= 2){
-            return Interpret(token, cursor, cf, ctx);
-        }else
-        if(areAllNames(token, ctx)){
-            return bStoreConstruct(token->first, token, token->inner, ctx);
-        }else{
-        // Or list?
-            return bListConstruct(token, token->inner, ctx);
+    opcode = __cv_resolve_opcode(first, kind);
+
+    namerCheck = CV::NamerCheck::VALID;
+    symbol = 0;
+    if(opcode == CV::Opcode::NAMER){
+        literal = first.substr(1);
+        namerCheck = __cv_check_namer(literal, line);
+        symbol = CV::Intern(literal);
+    }else
+    if(kind == CV::TokenKind::NAME){
+        symbol = CV::Intern(first);
+    }
+
+    // A failing parse is kept as an empty body: the prefix swallows it either way
+    guarded.clear();
+    if(opcode == CV::Opcode::TRY && first.size() > 1){
+        auto shadowCursor = CV::MakeRef<CV::Cursor>();
+        auto root = CV::BuildTree(std::string(first.begin() + 1, first.end()), shadowCursor);
+        if(!shadowCursor->error){
+            guarded = std::move(root);
         }
-    }else{    
-        /*
-            b:store
-        */
-        if(token->first == "b:store"){
-            return bStoreConstruct(token->first, token, token->inner, ctx);
-        }else
-        /*
-            b:list
-        */
-        if(token->first == "b:list"){
-            return bListConstruct(token, token->inner, ctx);
-        }else
-        /*
-            SKIP / RETURN / YIELD
-        */
-        if(token->first == "skip" || token->first == "return" || token->first == "yield"){
-            if(token->inner.size() > 1){
-                cursor->setError(CV_ERROR_MSG_MISUSED_IMPERATIVE, "'"+token->first+"' expects no more than 1 operand ("+token->first+" VALUE)", token);
-                return ctx->buildNil();
-            }
-            
-            int type = CV::ControlFlowState::CONTINUE;
-            if(token->first == "skip"){
-                type = CV::ControlFlowState::SKIP;
-            }else
-            if(token->first == "yield"){
-                type = CV::ControlFlowState::YIELD;
-            }else
-            if(token->first == "return"){
-                type = CV::ControlFlowState::RETURN;
-            }
+    }
+}
 
-            auto r = ctx->buildNil();
-            cf->state = type;
+// The token's text as a name. Literals don't come interned, they only get here to be reported as bad names
+static CV::Symbol __cv_token_symbol(const CV::TokenType &token){
+    return token->kind == CV::TokenKind::NAME ? token->symbol : CV::Intern(token->first);
+}
 
-            if(token->inner.size() > 0){
-                r = Interpret(token->inner[0], cursor, cf, ctx);
-                if(cursor->error){
-                    cursor->subject = token;
-                    return ctx->buildNil();
-                }
-            }
+/*
+    The parser works in a single pass over the source: ScanTokens normalizes the input once (comments, escape
+    sequences, tabs and line breaks) into a flat buffer while recording where every bracket group and string
+    closes. The tree is then built straight out of that buffer by jumping over nested groups, so no part of the
+    source is re-scanned or re-copied for every level of nesting.
+*/
+struct TokenSpan {
+    unsigned from;
+    unsigned to;
+    unsigned line;
+};
 
-            return r;
-        }else   
-        /*
-            FN
-        */
-        if(token->first == "fn"){
-            if(token->inner.size() != 2){
-                cursor->setError(CV_ERROR_MSG_MISUSED_IMPERATIVE, "'"+token->first+"' expects exactly 3 tokens ("+token->first+" [arguments][code])", token);
-                return ctx->buildNil();
-            }
-            auto fn = std::make_shared<CV::DataFunction>();
-            fn->isLambda = false;
-            fn->body = token->inner[1];
+struct SourceScan {
+    // Normalized source. Every top level statement is a span in here
+    std::string text;
+    // For every '[' and opening quote in 'text', the position of its closing counterpart
+    std::vector<unsigned> closing;
+    std::vector<TokenSpan> top;
+};
 
-            auto paramNameList = token->inner[0]->inner;
-            paramNameList.insert(paramNameList.begin(), token->inner[0]);
+static bool ScanTokens(const std::string &source, const CV::CursorType &cursor, int startLine, SourceScan &scan){
+    int open = 0;
+    bool onString = false;
+    bool onComment = false;
+    int leftBrackets = 0;
+    int rightBrackets = 0;
+    int cline = startLine;
+    // Count outer brackets
+    for(int i = 0; i < source.size(); ++i){
+        char c = source[i];
+        if(c == '\n'){
+            ++cline;
+        }else
+        if(c == '\\' && i < source.size()-1 && source[i+1] == '\''){
+            i += 1;
+        }else
+        if(c == '\''){
+            onString = !onString;
+        }else
+        if(c == '[' && !onString){
+            if(open == 0) ++leftBrackets;
+            ++open;
+        }else
+        if(c == ']' && !onString){
+            if(open == 1) ++rightBrackets;
+            --open;
+        }
+    }
+    // Throw mismatching brackets
+    if(leftBrackets != rightBrackets){
+        cursor->setError("Syntax Error", "Mismatching brackets", cline+1);
+        return false;
+    }
+    // Throw mismatching quotes
+    if(onString){
+        cursor->setError("Syntax Error", "Mismatching quotes", cline);
+        return false;
+    }
+    // Add missing brackets for simple statements
+    std::string wrapped;
+    bool wrap = ((leftBrackets+rightBrackets)/2 > 1) || (leftBrackets+rightBrackets) == 0 || source[0] != '[' || source[source.length()-1] != ']';
+    if(wrap){
+        wrapped = "[" + source + "]";
+    }
+    const std::string &input = wrap ? wrapped : source;
+    int size = input.size();
+
+    scan.text.clear();
+    scan.text.reserve(size);
+    scan.closing.assign(size, 0);
+    scan.top.clear();
+
+    std::vector<unsigned> brackets;
+    unsigned quote = 0;
+    unsigned begin = 0;
+    auto &text = scan.text;
+
+    auto push = [&](){
+        if(text.size() > begin){
+            scan.top.push_back({begin, static_cast<unsigned>(text.size()), static_cast<unsigned>(cline)});
+        }
+        begin = text.size();
+    };
 
-            auto hasParam = [&](const std::string &name){
-                for(const auto &p : fn->params){
-                    if(p == name){
-                        return true;
-                    }
-                }
-                return false;
-            };
+    open = 0;
+    onString = false;
+    cline = startLine;
 
-            if(paramNameList.size() == 1 && paramNameList[0]->first == "@"){
-                fn->isVariadic = true;
-            }else{
-                for(int i = 0; i < paramNameList.size(); ++i){
-                    auto &name = paramNameList[i]->first;
-                    if(!CV::Tools::isValidVarName(name)){
-                        cursor->setError(CV_ERROR_MSG_MISUSED_IMPERATIVE, "'"+token->first+"' argument name '"+name+"' is an invalid", token);
-                        return ctx->buildNil();                 
-                    }
-                    if(CV::Tools::isReservedWord(name)){
-                        cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+token->first+"' argument name '"+name+"' is a name of native constructor which cannot be overriden", token);
-                        return ctx->buildNil();
-                    }  
-                    if(hasParam(name)){
-                        cursor->setError(
-                            CV_ERROR_MSG_MISUSED_IMPERATIVE,
-                            "'"+token->first+"' argument name '"+name+"' is duplicated",
-                            token
-                        );
-                        return ctx->buildNil();
-                    }                    
-                    if(name == "@"){
-                        cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+token->first+"' argument name '"+name+"' is illegal in definitions with more than one argument", token);
-                        return ctx->buildNil();                 
-                    }
-                    fn->params.push_back(name);
-                }
+    // Parse
+    for(int i = 0; i < size; ++i){
+        char c = input[i];
+        if(i < size-1 && c == '\\' && input[i+1] == '\'' && onString){
+            text += '\\';
+            text += '\'';
+            i += 1;
+            continue;
+        }else      
+        if(c == '\'' && !onComment){
+            // An escaped quote may only appear within a string
+            if(!onString && i > 0 && input[i-1] == '\\'){
+                cursor->setError("Syntax Error", "Mismatching quotes", cline);
+                return false;
             }
-
-            return fn;
-            
-        }else  
-        /*
-            CC
-        */
-        if(token->first == "cc"){
-            if(token->inner.size() != 1){
-                cursor->setError(
-                    CV_ERROR_MSG_MISUSED_IMPERATIVE,
-                    "'"+token->first+"' expects exactly 2 tokens ("+token->first+" VALUE)",
-                    token
-                );  
-                return ctx->buildNil();
+            onString = !onString;
+            if(onString){
+                quote = text.size();
+            }else{
+                scan.closing[quote] = text.size();
             }
-
-            auto target = Interpret(token->inner[0], cursor, cf, ctx);
-            if(cursor->error){
-                cursor->subject = token;
-                return ctx->buildNil();
+            text += c;
+        }else        
+        if(c == '#' && !onString){
+            onComment = true;
+            continue;
+        }else
+        if(i < size-1 && c == '\\' && input[i+1] == 'n' && onString){
+            text += '\n';
+            ++i;
+            continue;
+        }else            
+        if(c == '\t'){
+            text +=  ' ';
+        }else
+        if(c == '\n' && !onString){
+            ++cline;
+            onComment = false;
+            continue;
+        }else
+        if(onComment){
+            continue;
+        }else
+        if(c == '[' && !onString){
+            if(open > 0){
+                brackets.push_back(text.size());
+                text += c;
             }
-            if(cf->state == CV::ControlFlowState::YIELD){
-                return target;
-            }            
-
-            return ctx->copy(target->unwrap());
+            ++open;
         }else
-        /*
-            MUT
-        */
-        if(token->first == "mut"){
-            if(token->inner.size() != 2){
-                cursor->setError(CV_ERROR_MSG_MISUSED_IMPERATIVE, "'"+token->first+"' expects exactly 3 tokens ("+token->first+" NAME VALUE)", token);
-                return ctx->buildNil();
+        if(c == ']' && !onString){
+            if(open > 1){
+                scan.closing[brackets.back()] = text.size();
+                brackets.pop_back();
+                text += c;
+            }            
+            --open;
+            // Anything closing below the outermost statement can't be repaired
+            if(open < 0 || open == 0 && i < size-1){
+                cursor->setError("Syntax Error", "Mismatching brackets", cline);
+                return false;
             }
-            
-            auto nameRef = ctx->getNamed(token->inner[0]->first);
-            if(!nameRef.first || !nameRef.second){
-                cursor->setError(CV_ERROR_MSG_UNDEFINED_IMPERATIVE, "Name '"+token->first+"'", token);
-                return ctx->buildNil();
+            if(open == 1 || i == size-1){
+                push();
+            }
+        }else
+        if(i == size-1){
+            if(text.size() > begin){
+                text += c;
             }
-            auto subject = nameRef.second->unwrap();
+            push();
+        }else
+        if(c == ' ' && open == 1 && !onString){
+            push();
+        }else{
+            text += c;
+        }
+    }
 
-            auto target = Interpret(token->inner[1], cursor, cf, ctx);
-            if(cursor->error){
-                cursor->subject = token;
-                return ctx->buildNil();
-            } 
-            if(cf->state == CV::ControlFlowState::YIELD){
-                return target;
-            }     
-            target = target->unwrap();
+    if(onString){
+        cursor->setError("Syntax Error", "Mismatching quotes", cline);
+        return false;
+    }
 
-            if(subject->type != CV::DataType::NUMBER && subject->type != CV::DataType::STRING){
-                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+token->first+"' may only accept NUMBER or STRING types", token);
-                return ctx->buildNil();
-            }
+    // A comment running until the end of the input swallows whatever brackets were left to close
+    if(onComment && open > 0){
+        while(!brackets.empty()){
+            scan.closing[brackets.back()] = text.size();
+            brackets.pop_back();
+            text += ']';
+        }
+        push();
+        open = 0;
+    }
 
-            if(target->type != subject->type){
-                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+token->first+"' may only mutate same types", token);
-                return ctx->buildNil();
-            }
+    if(open != 0 || !brackets.empty()){
+        cursor->setError("Syntax Error", "Mismatching brackets", cline);
+        return false;
+    }
 
-            switch(subject->type){
-                case CV::DataType::STRING: {
-                    std::static_pointer_cast<CV::DataString>(subject)->v = std::static_pointer_cast<CV::DataString>(target)->v;
-                };
-                case CV::DataType::NUMBER: {
-                    std::static_pointer_cast<CV::DataNumber>(subject)->v = std::static_pointer_cast<CV::DataNumber>(target)->v;
-                };                
-            }
+    return true;
+}
 
-            return subject;
-        }else  
-        /*
-            IMPORT
-        */
-        if(token->first == "import"){
-            if(token->inner.size() != 1){
-                cursor->setError(
-                    CV_ERROR_MSG_MISUSED_IMPERATIVE,
-                    "'"+token->first+"' expects exactly 2 tokens ("+token->first+" NAME)",
-                    token
-                );
-                return ctx->buildNil();
-            }
-
-            auto fnamev = Interpret(token->inner[0], cursor, cf, ctx);
-            if(cursor->error){
-                cursor->subject = token;
-                return ctx->buildNil();
-            }
-            if(cf->state == CV::ControlFlowState::YIELD){
-                return fnamev;
+// Splits the statements found in [from, to) of a scan, skipping over nested groups and strings
+static void SplitSpan(const SourceScan &scan, unsigned from, unsigned to, unsigned line, std::vector<TokenSpan> &out){
+    auto &text = scan.text;
+    unsigned start = from;
+    unsigned i = from;
+    while(i < to){
+        char c = text[i];
+        if(c == '\''){
+            i = scan.closing[i] + 1;
+        }else
+        if(c == '['){
+            i = scan.closing[i] + 1;
+            out.push_back({start, i, line});
+            start = i;
+        }else
+        if(c == ' '){
+            if(i > start){
+                out.push_back({start, i, line});
             }
+            start = ++i;
+        }else{
+            ++i;
+        }
+    }
+    if(start < to){
+        out.push_back({start, to, line});
+    }
+}
 
-            fnamev = fnamev ? fnamev->unwrap() : nullptr;
+// A span made of a single bracket group is unwrapped, anything else is split as it is
+static std::vector<TokenSpan> UnwrapSpan(const SourceScan &scan, const TokenSpan &span){
+    std::vector<TokenSpan> inner;
+    if(scan.text[span.from] == '[' && scan.closing[span.from] == span.to-1){
+        SplitSpan(scan, span.from+1, span.to-1, span.line, inner);
+    }else{
+        SplitSpan(scan, span.from, span.to, span.line, inner);
+    }
+    return inner;
+}
 
-            if(!fnamev || fnamev->type != CV::DataType::STRING){
-                cursor->setError(
-                    CV_ERROR_MSG_LIBRARY_NOT_VALID,
-                    "'"+token->first+"' expects a STRING operand",
-                    token
-                );
-                return ctx->buildNil();
-            }
+static bool IsGroupSpan(const SourceScan &scan, const TokenSpan &span){
+    return span.to - span.from >= 3 && scan.text[span.from] == '[' && scan.text[span.to-1] == ']';
+}
 
-            auto fname = std::static_pointer_cast<CV::DataString>(fnamev)->v;
-            auto resolved = __cv_resolve_import_path(fname, ".cv");
+/*
+    Every token of a parse is carved out of the same arena, in the order the tree is built, so a program sits in a
+    few contiguous blocks instead of one heap allocation per node. Nothing is given back one token at a time: each
+    token holds the arena and the blocks go away with the last token of the program, wherever it ended up
+    (function bodies and such)
+*/
+struct TokenArena : CV::Counted {
+    std::vector<std::unique_ptr<char[]>> blocks;
+    std::size_t used;
+    std::size_t capacity;
+
+    TokenArena(){
+        used = 0;
+        capacity = 0;
+    }
 
-            if(!CV::Tools::fileExists(resolved)){
-                cursor->setError(
-                    CV_ERROR_MSG_LIBRARY_NOT_VALID,
-                    "No canvas library '"+resolved+"' was found",
-                    token
-                );
-                return ctx->buildNil();
-            }
+    void *take(std::size_t size, std::size_t align){
+        std::size_t at = (used + align - 1) & ~(align - 1);
+        if(blocks.empty() || at + size > capacity){
+            // Small parses ('?' bodies, REPL lines) stay small, big programs end up in 64KB blocks
+            capacity = std::max(size, std::min<std::size_t>(capacity == 0 ? 4096 : capacity * 2, 65536));
+            blocks.emplace_back(new char[capacity]);
+            at = 0;
+        }
+        used = at + size;
+        return blocks.back().get() + at;
+    }
 
-            auto result = CV::Import(resolved, ctx, cursor);
-            if(cursor->error){
-                cursor->subject = token;
-                return ctx->buildNil();
-            }
+    CV::TokenType build(){
+        CV::TokenType token(::new (take(sizeof(CV::Token), alignof(CV::Token))) CV::Token());
+        token->arena = CV::Ref<CV::Counted>(this);
+        return token;
+    }
+};
 
-            return result ? result : ctx->buildNil();
-        }else
-        /*
-            IMPORT:DYNAMIC-LIBRARY
-        */
-        if(token->first == "import:dynamic-library"){
-            if(token->inner.size() != 1){
-                cursor->setError(
-                    CV_ERROR_MSG_MISUSED_IMPERATIVE,
-                    "'"+token->first+"' expects exactly 2 tokens ("+token->first+" NAME)",
-                    token
-                );
-                return ctx->buildNil();
-            }
+void CV::Token::destroy() const {
+    if(!this->arena){
+        delete this;
+        return;
+    }
+    // Its memory stays in the arena, which goes once no token holds it
+    auto arena = std::move(const_cast<CV::Token*>(this)->arena);
+    this->~Token();
+}
 
-            auto fnamev = Interpret(token->inner[0], cursor, cf, ctx);
-            if(cursor->error){
-                cursor->subject = token;
-                return ctx->buildNil();
-            }
-            if(cf->state == CV::ControlFlowState::YIELD){
-                return fnamev;
-            }
+static CV::TokenType BuildToken(const SourceScan &scan, const TokenSpan &span, TokenArena &arena){
+    auto inner = UnwrapSpan(scan, span);
 
-            fnamev = fnamev ? fnamev->unwrap() : nullptr;
+    auto token = arena.build();
+    token->line = span.line;
 
-            if(!fnamev || fnamev->type != CV::DataType::STRING){
-                cursor->setError(
-                    CV_ERROR_MSG_LIBRARY_NOT_VALID,
-                    "'"+token->first+"' expects a STRING operand",
-                    token
-                );
-                return ctx->buildNil();
-            }
+    if(inner.size() > 0){
+        auto &target = inner[0];
+        if(IsGroupSpan(scan, target)){
+            token->inner.reserve(inner.size());
+            token->inner.push_back(BuildToken(scan, target, arena));
+        }else{
+            token->first.assign(scan.text, target.from, target.to - target.from);
+            token->inner.reserve(inner.size() - 1);
+        }
+        for(int i = 1; i < inner.size(); ++i){
+            token->inner.push_back(BuildToken(scan, inner[i], arena));
+        }
+    }
 
-            auto fname = std::static_pointer_cast<CV::DataString>(fnamev)->v;
+    // Once, with everything in place
+    token->refresh();
+    return token;
+}
 
-            std::string ext = ".so";
-            if(CV::PLATFORM == CV::SupportedPlatform::WINDOWS){
-                ext = ".dll";
-            }else
-            if(CV::PLATFORM == CV::SupportedPlatform::OSX){
-                ext = ".dylib";
-            }
+static int CountStatements(const std::string &input, const CV::CursorType &cursor, int line){
+    SourceScan scan;
+    if(!ScanTokens(input, cursor, line, scan)){
+        return 0;
+    }
+    return scan.top.size();
+}
 
-            auto resolved = __cv_resolve_import_path(fname, ext);
+std::vector<CV::TokenType> CV::BuildTree(
+    const std::string &input,
+    const CV::CursorType &cursor
+){
+    if(input.size() == 0){
+        cursor->setError("Syntax Error", "Empty input", 1);
+        return {};
+    }
 
-            if(!CV::Tools::fileExists(resolved)){
-                cursor->setError(
-                    CV_ERROR_MSG_LIBRARY_NOT_VALID,
-                    "No dynamic library '"+resolved+"' was found",
-                    token
-                );
-                return ctx->buildNil();
-            }
+    auto needsProgramWrap = [&](const std::string &src) -> bool {
+        // 'src' has no line breaks left so a comment here runs until the end, leaving the scan incomplete. The
+        // statements found until then are still good enough, errors are reported by the scan of the actual input
+        SourceScan scan;
+        ScanTokens(src, CV::MakeRef<CV::Cursor>(), 1, scan);
 
-            auto result = CV::ImportDynamicLibrary(resolved, fname, ctx, cursor);
-            if(cursor->error){
-                cursor->subject = token;
-                return ctx->buildNil();
-            }
+        if(scan.top.empty()){
+            return false;
+        }
 
-            return result ? result : ctx->buildNil();
-        }else                
-        /*
-            LET
-        */
-        if(token->first == "let"){
-            if(token->inner.size() != 2){
-                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+token->first+"' expects exactly 3 tokens ("+token->first+" NAME VALUE)", token);
-                return ctx->buildNil();
+        for(const auto &span : scan.top){
+            if(span.to - span.from < 2 || scan.text[span.from] != '[' || scan.text[span.to-1] != ']'){
+                return true;
             }
+        }
 
-            auto &nameToken = token->inner[0];
-            auto &insToken = token->inner[1];
-
-            if(nameToken->inner.size() != 0){
-                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+token->first+"' expects NAME as second operand", token);
-                return ctx->buildNil();             
+        // A program made only of namer assignments like [~a [b] c] gets its own wrap too
+        for(const auto &span : scan.top){
+            auto inner = UnwrapSpan(scan, span);
+            if(inner.size() != 2 || IsGroupSpan(scan, inner[0])){
+                return false;
             }
-            auto &name = nameToken->first;
-            if(!CV::Tools::isValidVarName(name)){
-                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+token->first+"' second operand '"+name+"' is an invalid name", token);
-                return ctx->buildNil();
+            if(inner[0].to - inner[0].from < 2 || scan.text[inner[0].from] != '~'){
+                return false;
             }
-            if(CV::Tools::isReservedWord(name)){
-                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+token->first+"' second operand '"+name+"' is a name of native constructor which cannot be overriden", token);
-                return ctx->buildNil();
-            }            
+        }
 
-            auto nameRef = ctx->getNamed(name);
-            if(nameRef.first && nameRef.second && ctx->namedNames.count(name) == 0){
-                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "Name '"+name+"' is already defined", token);
-                return ctx->buildNil();
-            }
+        return true;
+    };
 
-            auto target = Interpret(insToken, cursor, cf, ctx);
-            if(cursor->error){
-                cursor->subject = token;
-                return ctx->buildNil();
-            }
-            if(cf->state == CV::ControlFlowState::YIELD){
-                return target;
-            }                             
+    auto isNamerAssignmentToken = [](const CV::TokenType &token) -> bool {
+        if(!token){
+            return false;
+        }
+        return token->first.size() >= 2 &&
+               token->first[0] == '~' &&
+               token->inner.size() == 1;
+    };
 
-            ctx->data[name] = target;
-            if(ctx->namedNames.count(name) == 1){
-                ctx->namedNames.erase(name);
-            }
+    auto cleanInput = CV::Tools::cleanTokenInput(input);
+    if(cleanInput.empty()){
+        cursor->setError("Syntax Error", "Empty input", 1);
+        return {};
+    }
 
-            return target;
+    std::string fixedInput = input;
 
-        }else   
-        /*
-            IF
-        */
-        if(token->first == "if"){
-            if(token->inner.size() != 2 && token->inner.size() != 3){
-                cursor->setError(
-                    CV_ERROR_MSG_MISUSED_IMPERATIVE,
-                    "'"+token->first+"' expects 3 or 4 tokens ("+token->first+" CONDITION TRUE-BRANCH [FALSE-BRANCH])",
-                    token
-                );
-                return ctx->buildNil();
-            }
+    if(cleanInput.front() != '[' || cleanInput.back() != ']'){
+        fixedInput = "[" + fixedInput;
+        if(!fixedInput.empty() && fixedInput.back() == '\n'){
+            fixedInput.back() = ']';
+        }else{
+            fixedInput += "]";
+        }
+    }
 
-            auto condition = Interpret(token->inner[0], cursor, cf, ctx);
-            if(cursor->error){
-                cursor->subject = token;
-                return ctx->buildNil();
-            }
+    cleanInput = CV::Tools::cleanTokenInput(fixedInput);
+    if(cleanInput.empty()){
+        cursor->setError("Syntax Error", "Empty input", 1);
+        return {};
+    }
 
-            if(cf->state == CV::ControlFlowState::YIELD){
-                return condition;
-            }
+    if(needsProgramWrap(cleanInput)){
+        fixedInput = "[" + fixedInput + "]";
+    }
 
-            if(cf->state == CV::ControlFlowState::RETURN ||
-               cf->state == CV::ControlFlowState::SKIP){
-                return condition;
-            }
+    SourceScan scan;
+    if(!ScanTokens(fixedInput, cursor, 1, scan) || cursor->error){
+        return {};
+    }
 
-            if(__cv_get_boolean_value(condition)){
-                return Interpret(token->inner[1], cursor, cf, ctx);
-            }
+    std::vector<CV::TokenType> root;
+    auto arena = CV::MakeRef<TokenArena>();
 
-            if(token->inner.size() == 3){
-                return Interpret(token->inner[2], cursor, cf, ctx);
-            }
+    for(int i = 0; i < static_cast<int>(scan.top.size()); ++i){
+        root.push_back(BuildToken(scan, scan.top[i], *arena));
+    }
+    if(root.size() > 1){
+        bool allTopLevelNamerAssignments = true;
 
-            return ctx->buildNil();
-        }else            
-        /*
-            WHILE
-        */
-        if(token->first == "while"){
-            if(token->inner.size() < 2){
-                cursor->setError(
-                    CV_ERROR_MSG_MISUSED_IMPERATIVE,
-                    "'"+token->first+"' expects at least 3 tokens ("+token->first+" CONDITION BODY...)",
-                    token
-                );
-                return ctx->buildNil();
+        for(const auto &t : root){
+            if(!isNamerAssignmentToken(t)){
+                allTopLevelNamerAssignments = false;
+                break;
             }
+        }
 
-            auto result = ctx->buildNil();
-
-            while(true){
-                auto iterCtx = ctx->buildContext(true);
+        if(allTopLevelNamerAssignments){
+            auto grouped = CV::MakeRef<CV::Token>("", root[0]->line);
+            grouped->first = "";
+            grouped->inner = root;
+            grouped->solved = true;
+            grouped->refresh();
 
-                auto condition = Interpret(token->inner[0], cursor, cf, iterCtx);
-                if(cursor->error){
-                    cursor->subject = token;
-                    return ctx->buildNil();
-                }
+            root.clear();
+            root.push_back(grouped);
+        }
+    }    
 
-                if(cf->state == CV::ControlFlowState::RETURN){
-                    return condition;
-                }
+    if(root.empty()){
+        return {};
+    }
 
-                if(cf->state == CV::ControlFlowState::YIELD){
-                    return condition;
-                }
+    return root;
+}
 
-                if(cf->state == CV::ControlFlowState::SKIP){
-                    cf->state = CV::ControlFlowState::CONTINUE;
-                    continue;
-                }
+//
+// PRECOMPILED TREES
+//
+/*
+    A '.cvc' file is the tree BuildTree made out of a script, stored next to it. It's trusted only while the
+    script keeps the modification time and size it had when it was precompiled and this build reads the same
+    format and version. Anything else (missing, stale or damaged) is a miss and the script is parsed as usual.
+
+    Layout, native endianness:
+        header  'CVC' 0, format, version[3], mtime seconds, mtime nanoseconds, size, number of roots
+        tokens  depth first: line, number of inner tokens, length of 'first' followed by its bytes
+
+    Caches are written aside and renamed over the old one, so a process still reading it keeps a whole tree
+*/
+static const uint32_t CV_CVC_FORMAT = 1;
+// Deeper trees than this are taken for damage, nothing to do with what the reader could take
+static const uint32_t CV_CVC_MAX_DEPTH = 4096;
+
+// What a script file looked like when something was derived from it
+struct __cv_file_stamp {
+    int64_t seconds;
+    int64_t nanoseconds;
+    uint64_t size;
+
+    bool operator==(const __cv_file_stamp &other) const {
+        return seconds == other.seconds && nanoseconds == other.nanoseconds && size == other.size;
+    }
+};
 
-                if(!__cv_get_boolean_value(condition)){
-                    break;
-                }
+static bool __cv_stamp_file(const std::string &path, __cv_file_stamp &stamp){
+    struct stat st;
+    if(stat(path.c_str(), &st) != 0 || !S_ISREG(st.st_mode)){
+        return false;
+    }
+    stamp.seconds = st.st_mtime;
+#if (_CV_PLATFORM == _CV_PLATFORM_TYPE_LINUX)
+    stamp.nanoseconds = st.st_mtim.tv_nsec;
+#else
+    stamp.nanoseconds = 0;
+#endif
+    stamp.size = st.st_size;
+    return true;
+}
 
-                result = __cv_run_children(token, 1, cursor, cf, iterCtx);
-                if(cursor->error){
-                    cursor->subject = token;
-                    return ctx->buildNil();
-                }
+struct __cv_cvc_header {
+    char magic[4];
+    uint32_t format;
+    uint32_t version[3];
+    __cv_file_stamp stamp;
+    uint32_t roots;
+};
 
-                if(cf->state == CV::ControlFlowState::RETURN){
-                    return result;
-                }
+static std::string __cv_cvc_path(const std::string &path){
+    return path + "c";
+}
 
-                if(cf->state == CV::ControlFlowState::YIELD){
-                    return result;
-                }
+// Identity of the script the cache is keyed to
+static bool __cv_cvc_stamp(const std::string &path, __cv_cvc_header &header){
+    if(!__cv_stamp_file(path, header.stamp)){
+        return false;
+    }
+    std::memcpy(header.magic, "CVC", 4);
+    header.format = CV_CVC_FORMAT;
+    for(int i = 0; i < 3; ++i){
+        header.version[i] = static_cast<uint32_t>(CV::VERSION[i]);
+    }
+    header.roots = 0;
+    return true;
+}
 
-                if(cf->state == CV::ControlFlowState::SKIP){
-                    cf->state = CV::ControlFlowState::CONTINUE;
-                    continue;
-                }
-            }
+static void __cv_cvc_write_token(std::string &out, const CV::TokenType &token){
+    uint32_t fields[3] = {
+        token->line,
+        static_cast<uint32_t>(token->inner.size()),
+        static_cast<uint32_t>(token->first.size())
+    };
+    out.append(reinterpret_cast<const char*>(fields), sizeof(fields));
+    out.append(token->first);
+    for(auto &inner : token->inner){
+        __cv_cvc_write_token(out, inner);
+    }
+}
 
-            return result;
-        }else
-        /*
-            FOR
-        */
-        if(token->first == "for"){
-            if(token->inner.size() < 2){
-                cursor->setError(
-                    CV_ERROR_MSG_MISUSED_IMPERATIVE,
-                    "'"+token->first+"' expects at least 3 tokens ("+token->first+" [~name [from to [step]]] BODY...)",
-                    token
-                );
-                return ctx->buildNil();
-            }
+struct __cv_cvc_reader {
+    const char *at;
+    const char *end;
 
-            auto clauseRaw = Interpret(token->inner[0], cursor, cf, ctx);
-            if(cursor->error){
-                cursor->subject = token;
-                return ctx->buildNil();
-            }
-            if(cf->state == CV::ControlFlowState::YIELD){
-                return clauseRaw;
-            }
+    bool read(void *into, std::size_t n){
+        if(static_cast<std::size_t>(end - at) < n){
+            return false;
+        }
+        std::memcpy(into, at, n);
+        at += n;
+        return true;
+    }
 
-            if(!clauseRaw || clauseRaw->type != CV::DataType::PROXY){
-                cursor->setError(
-                    CV_ERROR_MSG_ILLEGAL_ITERATOR,
-                    "'"+token->first+"' expects first operand to evaluate into a named proxy like [~x [0 10]]",
-                    token
-                );
-                return ctx->buildNil();
+    // Null if the token doesn't fit in what's left, or claims more inner tokens than could
+    CV::TokenType token(TokenArena &arena, uint32_t depth = 0){
+        uint32_t fields[3];
+        if(depth > CV_CVC_MAX_DEPTH || !read(fields, sizeof(fields)) || static_cast<std::size_t>(end - at) < fields[2]){
+            return nullptr;
+        }
+        auto token = arena.build();
+        token->line = fields[0];
+        token->first.assign(at, fields[2]);
+        at += fields[2];
+        if(fields[1] > static_cast<std::size_t>(end - at) / sizeof(fields)){
+            return nullptr;
+        }
+        token->inner.reserve(fields[1]);
+        for(uint32_t i = 0; i < fields[1]; ++i){
+            auto inner = this->token(arena, depth + 1);
+            if(!inner){
+                return nullptr;
             }
+            token->inner.push_back(inner);
+        }
+        token->refresh();
+        return token;
+    }
+};
 
-            auto clauseProxy = std::static_pointer_cast<CV::DataProxy>(clauseRaw);
-
-            if(clauseProxy->pname.size() == 0){
-                cursor->setError(
-                    CV_ERROR_MSG_ILLEGAL_ITERATOR,
-                    "'"+token->first+"' iterator is missing a name",
-                    token
-                );
-                return ctx->buildNil();
-            }
+namespace CVCRead {
+    enum CVCRead : int {
+        LOADED,
+        // Missing, stale or made by another build: nothing wrong with it, it just doesn't apply
+        MISSED,
+        // Made for this very script but it doesn't hold a tree
+        DAMAGED
+    };
+}
 
-            if(!clauseProxy->target){
-                cursor->setError(
-                    CV_ERROR_MSG_ILLEGAL_ITERATOR,
-                    "'"+token->first+"' iterator proxy is missing a range target",
-                    token
-                );
-                return ctx->buildNil();
-            }
+static int __cv_cvc_read(const char *data, std::size_t size, const __cv_cvc_header &expected, std::vector<CV::TokenType> &root){
+    __cv_cvc_header header{};
+    __cv_cvc_reader reader = { data, data + size };
+    if(!reader.read(&header, sizeof(header))){
+        return CVCRead::MISSED;
+    }
+    if(std::memcmp(header.magic, expected.magic, 4) != 0 || header.format != expected.format ||
+       std::memcmp(header.version, expected.version, sizeof(header.version)) != 0 ||
+       !(header.stamp == expected.stamp)){
+        return CVCRead::MISSED;
+    }
+    if(header.roots > static_cast<std::size_t>(reader.end - reader.at) / (3 * sizeof(uint32_t))){
+        return CVCRead::DAMAGED;
+    }
+    auto arena = CV::MakeRef<TokenArena>();
+    root.reserve(header.roots);
+    for(uint32_t i = 0; i < header.roots; ++i){
+        auto token = reader.token(*arena);
+        if(!token){
+            return CVCRead::DAMAGED;
+        }
+        root.push_back(token);
+    }
+    return reader.at == reader.end ? CVCRead::LOADED : CVCRead::DAMAGED;
+}
 
-            auto iterName = clauseProxy->pname;
-            auto rangeData = clauseProxy->target->unwrap();
+// Maps the cache in and rebuilds the tree out of it
+static int __cv_cvc_load(const std::string &path, std::vector<CV::TokenType> &root){
+    __cv_cvc_header expected{};
+    if(!__cv_cvc_stamp(path, expected)){
+        return CVCRead::MISSED;
+    }
+    auto cpath = __cv_cvc_path(path);
+    int loaded = CVCRead::MISSED;
+#if (_CV_PLATFORM == _CV_PLATFORM_TYPE_LINUX) || (_CV_PLATFORM == _CV_PLATFORM_TYPE_OSX)
+    int fd = open(cpath.c_str(), O_RDONLY);
+    if(fd < 0){
+        return CVCRead::MISSED;
+    }
+    struct stat st;
+    if(fstat(fd, &st) == 0 && st.st_size > 0){
+        void *data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if(data != MAP_FAILED){
+            loaded = __cv_cvc_read(static_cast<const char*>(data), st.st_size, expected, root);
+            munmap(data, st.st_size);
+        }
+    }
+    close(fd);
+#else
+    std::ifstream file(cpath, std::ios::binary);
+    if(!file){
+        return CVCRead::MISSED;
+    }
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    loaded = __cv_cvc_read(data.data(), data.size(), expected, root);
+#endif
+    if(loaded != CVCRead::LOADED){
+        root.clear();
+    }
+    return loaded;
+}
 
-            if(!rangeData || rangeData->type != CV::DataType::LIST){
-                cursor->setError(
-                    CV_ERROR_MSG_ILLEGAL_ITERATOR,
-                    "'"+token->first+"' iterator target must be a LIST like [from to] or [from to step]",
-                    token
-                );
-                return ctx->buildNil();
-            }
+std::vector<CV::TokenType> CV::LoadTree(
+    const std::string &path,
+    const CV::CursorType &cursor
+){
+    std::vector<CV::TokenType> root;
+    auto loaded = __cv_cvc_load(path, root);
+    if(loaded == CVCRead::LOADED){
+        return root;
+    }
+    // Parsing is still right, but the cache would be missed again and again until it's rewritten
+    if(loaded == CVCRead::DAMAGED){
+        fprintf(stderr, "Ignoring damaged '%s', precompile '%s' again to replace it\n", __cv_cvc_path(path).c_str(), path.c_str());
+    }
+    return CV::BuildTree(CV::Tools::readFile(path), cursor);
+}
 
-            auto range = std::static_pointer_cast<CV::DataList>(rangeData);
+bool CV::Precompile(
+    const std::string &path,
+    const CV::CursorType &cursor
+){
+    __cv_cvc_header header{};
+    if(!__cv_cvc_stamp(path, header)){
+        cursor->setError(CV_ERROR_MSG_LIBRARY_NOT_VALID, "'"+path+"' does not exist", 1);
+        return false;
+    }
 
-            if(range->v.size() != 2 && range->v.size() != 3){
-                cursor->setError(
-                    CV_ERROR_MSG_ILLEGAL_ITERATOR,
-                    "'"+token->first+"' iterator target expects [from to] or [from to step]",
-                    token
-                );
-                return ctx->buildNil();
-            }
+    auto root = CV::BuildTree(CV::Tools::readFile(path), cursor);
+    if(cursor->error){
+        return false;
+    }
 
-            auto fromData = range->v[0] ? range->v[0]->unwrap() : nullptr;
-            auto toData   = range->v[1] ? range->v[1]->unwrap() : nullptr;
+    header.roots = root.size();
+    std::string out(reinterpret_cast<const char*>(&header), sizeof(header));
+    for(auto &token : root){
+        __cv_cvc_write_token(out, token);
+    }
 
-            if(!fromData || fromData->type != CV::DataType::NUMBER ||
-            !toData   || toData->type   != CV::DataType::NUMBER){
-                cursor->setError(
-                    CV_ERROR_MSG_ILLEGAL_ITERATOR,
-                    "'"+token->first+"' bounds must be NUMBER values",
-                    token
-                );
-                return ctx->buildNil();
-            }
+    // Written aside and moved in place in one step, whoever has the old cache mapped keeps reading the old one
+    auto cpath = __cv_cvc_path(path);
+    bool written = false;
+#if (_CV_PLATFORM == _CV_PLATFORM_TYPE_LINUX) || (_CV_PLATFORM == _CV_PLATFORM_TYPE_OSX)
+    std::string tpath = cpath + ".XXXXXX";
+    int fd = mkstemp(&tpath[0]);
+    if(fd >= 0){
+        written = true;
+        for(std::size_t at = 0; written && at < out.size();){
+            auto n = write(fd, out.data() + at, out.size() - at);
+            written = n > 0;
+            at += written ? n : 0;
+        }
+        fchmod(fd, 0644);
+        written = close(fd) == 0 && written && rename(tpath.c_str(), cpath.c_str()) == 0;
+        if(!written){
+            unlink(tpath.c_str());
+        }
+    }
+#else
+    std::string tpath = cpath + ".tmp";
+    {
+        std::ofstream file(tpath, std::ios::binary | std::ios::trunc);
+        written = static_cast<bool>(file.write(out.data(), out.size()));
+    }
+    // rename() doesn't replace files here
+    std::remove(cpath.c_str());
+    written = written && std::rename(tpath.c_str(), cpath.c_str()) == 0;
+    if(!written){
+        std::remove(tpath.c_str());
+    }
+#endif
+    if(!written){
+        cursor->setError("Precompile Error", "Failed to write '"+cpath+"'", 1);
+        return false;
+    }
+    return true;
+}
 
-            CV_NUMBER current = std::static_pointer_cast<CV::DataNumber>(fromData)->v;
-            CV_NUMBER end     = std::static_pointer_cast<CV::DataNumber>(toData)->v;
-            CV_NUMBER step    = current <= end ? 1 : -1;
+static CV::Ref<CV::Data> __cv_run_children(
+    const CV::TokenType &parent,
+    int from,
+    const CV::CursorType &cursor,
+    const CV::ControlFlowType &cf,
+    const CV::ContextType &ctx
+){
+    auto result = ctx->buildNil();
 
-            if(range->v.size() == 3){
-                auto stepData = range->v[2] ? range->v[2]->unwrap() : nullptr;
-                if(!stepData || stepData->type != CV::DataType::NUMBER){
-                    cursor->setError(
-                        CV_ERROR_MSG_ILLEGAL_ITERATOR,
-                        "'"+token->first+"' step must be NUMBER",
-                        token
-                    );
-                    return ctx->buildNil();
-                }
-                step = std::static_pointer_cast<CV::DataNumber>(stepData)->v;
-            }
+    for(int i = from; i < static_cast<int>(parent->inner.size()); ++i){
+        result = CV::Interpret(parent->inner[i], cursor, cf, ctx);
+        if(cursor->error){
+            return ctx->buildNil();
+        }
 
-            if(step == 0){
-                cursor->setError(
-                    CV_ERROR_MSG_ILLEGAL_ITERATOR,
-                    "'"+token->first+"' step cannot be zero",
-                    token
-                );
-                return ctx->buildNil();
-            }
+        if(cf->state == CV::ControlFlowState::RETURN ||
+           cf->state == CV::ControlFlowState::YIELD ||
+           cf->state == CV::ControlFlowState::SKIP){
+            return result;
+        }
+    }
 
-            auto shouldRun = [&](CV_NUMBER n) -> bool {
-                return step > 0 ? (n < end) : (n > end);
-            };
+    return result;
+}
 
-            auto loopCtx = ctx->buildContext(true);
-            auto iterValue = loopCtx->buildNumber(current);
-            loopCtx->data[iterName] = iterValue;
+static bool __cv_get_boolean_value(const CV::Ref<CV::Data> &target){
+    auto v = target ? target->unwrap() : CV::Ref<CV::Data>(nullptr);
+    if(!v){
+        return false;
+    }
 
-            auto result = ctx->buildNil();
+    switch(v->type){
+        case CV::DataType::NIL:
+            return false;
+        case CV::DataType::NUMBER:
+            return CV::CastRef<CV::DataNumber>(v)->v != 0;
+        case CV::DataType::STRING:
+            return !CV::CastRef<CV::DataString>(v)->v.empty();
+        case CV::DataType::LIST:
+            return !CV::CastRef<CV::DataList>(v)->v.empty();
+        case CV::DataType::STORE:
+            return !CV::CastRef<CV::DataStore>(v)->v.empty();
+        default:
+            return true;
+    }
+}
 
-            while(shouldRun(iterValue->v)){
-                auto iterCtx = loopCtx->buildContext(true);
+static bool __cv_is_iterator_clause(const CV::TokenType &token){
+    return token &&
+           token->first.size() >= 2 &&
+           token->first[0] == '~' &&
+           token->inner.size() == 1;
+}
 
-                for(int i = 1; i < static_cast<int>(token->inner.size()); ++i){
-                    result = Interpret(token->inner[i], cursor, cf, iterCtx);
-                    if(cursor->error){
-                        cursor->subject = token;
-                        return ctx->buildNil();
-                    }
+#if (_CV_PLATFORM == _CV_PLATFORM_TYPE_LINUX) || (_CV_PLATFORM == _CV_PLATFORM_TYPE_OSX)
+    using __cv_dynlib_handle_t = void*;
+#elif (_CV_PLATFORM == _CV_PLATFORM_TYPE_WINDOWS)
+    using __cv_dynlib_handle_t = HMODULE;
+#endif
 
-                    if(cf->state == CV::ControlFlowState::RETURN){
-                        return result;
-                    }
+/*
+    Dynamic libraries are opened and registered once per runtime, keyed by their real path. The entry point runs
+    against a scratch context and whatever it bound there becomes the library's table, which every later import
+    (into any context) binds again without calling into the library. Functions in it are shared, anything else
+    is copied per import so no context sees another one's mutations. Entry points must only bind names into the
+    context they're given, never hold on to it
+*/
+struct __cv_dynamic_library {
+    int id;
+    __cv_dynlib_handle_t handle;
+    std::vector<std::pair<CV::Symbol, CV::Ref<CV::Data>>> table;
+};
 
-                    if(cf->state == CV::ControlFlowState::YIELD){
-                        return result;
-                    }
+static std::mutex __cv_loaded_dynamic_libs_mutex;
+static std::unordered_map<std::string, __cv_dynamic_library> __cv_loaded_dynamic_libs;
 
-                    if(cf->state == CV::ControlFlowState::SKIP){
-                        cf->state = CV::ControlFlowState::CONTINUE;
-                        break;
-                    }
-                }
-
-                iterValue->v += step;
-            }
+static std::string __cv_resolve_import_path(
+    const std::string &fname,
+    const std::string &defaultExt
+){
+    std::string resolved = fname;
 
-            return result;
-        }else
-        /*
-            FOREACH
-        */
-        if(token->first == "foreach"){
-            if(token->inner.size() < 2){
-                cursor->setError(
-                    CV_ERROR_MSG_MISUSED_IMPERATIVE,
-                    "'"+token->first+"' expects at least 3 tokens ("+token->first+" [~item SUBJECT] BODY...)",
-                    token
-                );
-                return ctx->buildNil();
-            }
+    if(CV::Tools::fileExtension(resolved) == ""){
+        resolved += defaultExt;
+    }
 
-            auto clauseRaw = Interpret(token->inner[0], cursor, cf, ctx);
-            if(cursor->error){
-                cursor->subject = token;
-                return ctx->buildNil();
-            }
-            if(cf->state == CV::ControlFlowState::YIELD){
-                return clauseRaw;
-            }
+    if(CV::Tools::fileExists("./" + resolved)){
+        resolved = "./" + resolved;
+    }else{
+        resolved = CV_LIB_HOME + "/" + resolved;
+    }
 
-            if(!clauseRaw || clauseRaw->type != CV::DataType::PROXY){
-                cursor->setError(
-                    CV_ERROR_MSG_ILLEGAL_ITERATOR,
-                    "'"+token->first+"' expects first operand to evaluate into a named proxy like [~item someList]",
-                    token
-                );
-                return ctx->buildNil();
-            }
+    return resolved;
+}
 
-            auto clauseProxy = std::static_pointer_cast<CV::DataProxy>(clauseRaw);
+// Appends a value to a LIST under construction, '^' proxies are expanded in place
+static bool __cv_list_append(
+    const CV::Ref<CV::DataList> &list,
+    const CV::Ref<CV::Data> &data,
+    const CV::TokenType &inc,
+    const CV::TokenType &origin,
+    const CV::CursorType &cursor,
+    const CV::ContextType &ctx
+){
+    if(data && data->type == CV::DataType::PROXY){
+        auto proxy = CV::CastRef<CV::DataProxy>(data);
 
-            if(clauseProxy->pname.size() == 0){
+        if(proxy->ptype == CV::Prefixer::EXPANDER){
+            if(!proxy->target){
                 cursor->setError(
-                    CV_ERROR_MSG_ILLEGAL_ITERATOR,
-                    "'"+token->first+"' iterator is missing a name",
-                    token
+                    CV_ERROR_MSG_MISUSED_PREFIX,
+                    "Expander Prefix '^' produced a proxy without target",
+                    inc
                 );
-                return ctx->buildNil();
+                cursor->subject = origin;
+                return false;
             }
 
-            if(!clauseProxy->target){
+            auto expanded = proxy->target->unwrap();
+            if(!expanded || expanded->type != CV::DataType::LIST){
                 cursor->setError(
-                    CV_ERROR_MSG_ILLEGAL_ITERATOR,
-                    "'"+token->first+"' iterator proxy is missing a subject target",
-                    token
+                    CV_ERROR_MSG_MISUSED_PREFIX,
+                    "Expander Prefix '^' expects target to resolve into a LIST",
+                    inc
                 );
-                return ctx->buildNil();
+                cursor->subject = origin;
+                return false;
             }
 
-            auto iterName = clauseProxy->pname;
-            auto subject = clauseProxy->target->unwrap();
-
-            std::vector<std::shared_ptr<CV::Data>> values;
-
-            if(!subject){
-                cursor->setError(
-                    CV_ERROR_MSG_ILLEGAL_ITERATOR,
-                    "'"+token->first+"' iterator target is null",
-                    token
-                );
-                return ctx->buildNil();
-            }
+            auto expandedList = CV::CastRef<CV::DataList>(expanded);
 
-            if(subject->type == CV::DataType::LIST){
-                auto list = std::static_pointer_cast<CV::DataList>(subject);
-                values = list->v;
-            }else
-            if(subject->type == CV::DataType::STORE){
-                auto store = std::static_pointer_cast<CV::DataStore>(subject);
-                for(auto &it : store->v){
-                    values.push_back(it.second);
-                }
-            }else{
-                cursor->setError(
-                    CV_ERROR_MSG_ILLEGAL_ITERATOR,
-                    "'"+token->first+"' expects subject to be LIST or STORE",
-                    token
-                );
-                return ctx->buildNil();
+            for(int j = 0; j < static_cast<int>(expandedList->v.size()); ++j){
+                list->v.push_back(expandedList->v[j]);
             }
 
-            auto loopCtx = ctx->buildContext(true);
-            auto result = ctx->buildNil();
+            return true;
+        }
+    }
 
-            for(int i = 0; i < static_cast<int>(values.size()); ++i){
-                loopCtx->data[iterName] = values[i];
+    list->v.push_back(data ? __cv_unshared(data->unwrap()) : ctx->buildNil());
+    return true;
+}
 
-                auto iterCtx = loopCtx->buildContext(true);
+/*
+    Same as getNamed for the token's name, going through its inline cache. Contexts made after the cache was filled
+    (iterations, arguments, parameters) are looked into directly, they're small and can't be what the cache saw. The
+    first older one must be the context the cache was keyed to, anything above it is still what was found back then
+    unless a name was bound since, which bumps the version. Filling marks the contexts walked from the key up to
+    where the name was found as seen, except frozen ones, which other threads may be walking too and always bump.
+    'crossed' tells whether a fork was walked through before the name was found
+*/
+static const CV::Ref<CV::Data> *__cv_lookup_name(const CV::TokenType &token, CV::Context *ctx, bool &crossed){
+    auto &cache = __cv_name_caches[(reinterpret_cast<std::uintptr_t>(token.get()) >> 4) % CV_NAME_CACHE_SIZE];
+    if(cache.token != token.get() || cache.symbol != token->symbol){
+        cache = __cv_name_cache{token.get(), token->symbol, 0, 0, 0, NULL, false};
+    }
 
-                for(int j = 1; j < static_cast<int>(token->inner.size()); ++j){
-                    result = Interpret(token->inner[j], cursor, cf, iterCtx);
-                    if(cursor->error){
-                        cursor->subject = token;
-                        return ctx->buildNil();
-                    }
+    CV::Context *key = NULL;
+    const CV::Ref<CV::Data> *slot = NULL;
+    crossed = false;
 
-                    if(cf->state == CV::ControlFlowState::RETURN){
-                        return result;
-                    }
+    for(auto c = ctx; c; c = c->head.get()){
+        if(c->id <= cache.serial){
+            if(c->id == cache.context && cache.version == __cv_names_version.load(std::memory_order_relaxed)){
+                ++__cv_name_cache_stats.hits;
+                crossed = crossed || cache.crossed;
+                return cache.slot;
+            }
+            key = c;
+            break;
+        }
+        auto it = c->data.find(token->symbol);
+        if(it != c->data.end()){
+            key = c;
+            slot = &it->second;
+            break;
+        }
+        crossed = crossed || c->isFork;
+    }
 
-                    if(cf->state == CV::ControlFlowState::YIELD){
-                        return result;
-                    }
+    ++__cv_name_cache_stats.misses;
+
+    // Read before looking, a name bound meanwhile makes this fill stale right away rather than wrong
+    auto version = __cv_names_version.load(std::memory_order_relaxed);
+    auto serial = __cv_context_serial.load(std::memory_order_relaxed);
+    CV::Context *found = NULL;
+    bool forked = false;
+    for(auto c = key; c; c = c->head.get()){
+        auto it = c->data.find(token->symbol);
+        if(it != c->data.end()){
+            slot = &it->second;
+            found = c;
+            break;
+        }
+        forked = forked || c->isFork;
+    }
 
-                    if(cf->state == CV::ControlFlowState::SKIP){
-                        cf->state = CV::ControlFlowState::CONTINUE;
-                        break;
-                    }
-                }
+    if(slot){
+        for(auto c = key; c; c = c->head.get()){
+            if(!c->seen && !c->frozen.load(std::memory_order_relaxed)){
+                c->seen = true;
             }
-
-            return result;
-        }else
-        // TRY / IGNORE-ERROR PREFIXER
-        if(token->first[0] == '?'){
-            if(token->inner.size() != 0){
-                cursor->setError(
-                    CV_ERROR_MSG_MISUSED_PREFIX,
-                    "Try Prefix '"+token->first+"' expects no values",
-                    token
-                );
-                return ctx->buildNil();
+            if(c == found){
+                break;
             }
+        }
+        cache.context = key->id;
+        cache.version = version;
+        cache.serial = serial;
+        cache.slot = slot;
+        cache.crossed = forked;
+        crossed = crossed || forked;
+    }
 
-            if(token->first.size() == 1){
-                cursor->setError(
-                    CV_ERROR_MSG_MISUSED_PREFIX,
-                    "Try Prefix '"+token->first+"' expects an appended body",
-                    token
-                );
-                return ctx->buildNil();
-            }
+    return slot;
+}
 
-            std::string statement = std::string(token->first.begin() + 1, token->first.end());
+static const CV::Ref<CV::Data> *__cv_lookup_name(const CV::TokenType &token, CV::Context *ctx){
+    bool crossed;
+    return __cv_lookup_name(token, ctx, crossed);
+}
 
-            // Shadow cursor so failures do not touch the outer/global cursor
-            auto shadowCursor = std::make_shared<CV::Cursor>();
+/*
+    The slot a name is read or changed through. A value found past a fork (in the context it was forked from or
+    above) is copied into the fork first, and the copy is what's handed out from then on: whatever changes it in
+    place ('mut', '++', '>>', a function it's passed to...) only ever reaches the fork's. Lists and stores are
+    copied the way 'cc' does, sharing their chunks until either side writes to one
+*/
+static const CV::Ref<CV::Data> *__cv_lookup_mutable_name(const CV::TokenType &token, CV::Context *ctx){
+    bool crossed;
+    auto named = __cv_lookup_name(token, ctx, crossed);
+    if(!crossed || !named || !*named){
+        return named;
+    }
+    switch((*named)->type){
+        case CV::DataType::NUMBER:
+        case CV::DataType::STRING:
+        case CV::DataType::LIST:
+        case CV::DataType::STORE:
+        case CV::DataType::PROXY:
+            break;
+        default:
+            return named;
+    }
+    auto fork = ctx;
+    while(!fork->isFork){
+        fork = fork->head.get();
+    }
+    auto value = *named;
+    if(value->type == CV::DataType::PROXY){
+        auto proxy = CV::CastRef<CV::DataProxy>(fork->copy(value));
+        if(proxy->target){
+            proxy->target = fork->copy(proxy->target);
+        }
+        return &fork->setNamed(token->symbol, proxy);
+    }
+    return &fork->setNamed(token->symbol, fork->copy(value));
+}
 
-            auto root = CV::BuildTree(statement, shadowCursor);
-            if(shadowCursor->error){
-                return ctx->buildNil();
-            }
+static bool __cv_is_name_function(const CV::TokenType &token, const CV::ContextType &ctx){
+    if(!token->solved){
+        return false;
+    }
+    if(CV::Tools::isReservedWord(token->first)){
+        return true;
+    }
+    auto named = __cv_lookup_name(token, ctx.get());
+    if(!named || !*named){
+        return false;
+    }
+    auto data = *named;
+    if(data->type == CV::DataType::PROXY){
+        data = CV::CastRef<CV::DataProxy>(data)->target;
+    }
+    return data && (data->type == CV::DataType::FUNCTION ||
+            data->type == CV::DataType::STORE);
+}
 
-            if(root.size() == 0){
-                return ctx->buildNil();
-            }
+static bool __cv_are_all_names(const CV::TokenType &token){
+    if(token->inner.size() < 1){
+        return false;
+    }
 
-            auto previousState = cf->state;
-            auto previousPayload = cf->payload;
+    for(int i = 0; i < token->inner.size(); ++i){
+        auto &child = token->inner[i];
 
-            std::shared_ptr<CV::Data> result = ctx->buildNil();
+        if(child->first.size() < 2 || child->first[0] != '~'){
+            return false;
+        }
 
-            for(int i = 0; i < static_cast<int>(root.size()); ++i){
-                result = CV::Interpret(root[i], shadowCursor, cf, ctx);
+        if(child->inner.size() == 0){
+            return false;
+        }
+    }
 
-                if(shadowCursor->error){
-                    // Swallow the error and restore control-flow
-                    cf->state = previousState;
-                    cf->payload = previousPayload;
-                    return ctx->buildNil();
-                }
+    return true;
+}
 
-                if(cf->state == CV::ControlFlowState::YIELD ||
-                   cf->state == CV::ControlFlowState::RETURN ||
-                   cf->state == CV::ControlFlowState::SKIP){
-                    return result;
-                }
-            }
+static bool __cv_are_all_functions(const CV::TokenType &token, const CV::ContextType &ctx){
+    if(token->inner.size() < 1){
+        return false;
+    } 
+    
+    for(int i = 0; i < token->inner.size(); ++i){
+        if(token->inner[i]->first.size() == 0 || !__cv_is_name_function(token->inner[i], ctx)){
+            return false;
+        } 
+    }
+    return true;
+}
 
-            return result ? result : ctx->buildNil();
-        }else        
-        // TEMPLATE FORMATTER
-        if(token->first[0] == '%'){
-            auto templateCtx = ctx->buildContext(true);
-            std::string output = "";
+// What 'mut' changes for a bound value: the value itself or the target of a proxy, never a shared constant
+static CV::Ref<CV::Data> __cv_mutable_subject(const CV::Ref<CV::Data> &named){
+    if(named->type == CV::DataType::PROXY){
+        auto proxy = static_cast<CV::DataProxy*>(named.get());
+        if(proxy->target){
+            proxy->target = __cv_unshared(proxy->target);
+            return proxy->target;
+        }
+    }
+    return named;
+}
 
-            auto resolveTemplateName = [&](const std::string &name) -> std::string {
-                auto nameRef = templateCtx->getNamed(name);
-                if(nameRef.first && nameRef.second){
-                    auto value = nameRef.second->unwrap();
-                    if(!value){
-                        return "nil";
-                    }
+static bool __cv_mutate(
+    const CV::Ref<CV::Data> &subject,
+    const CV::Ref<CV::Data> &target,
+    const CV::TokenType &token,
+    const CV::CursorType &cursor
+){
+    if(subject->type != CV::DataType::NUMBER && subject->type != CV::DataType::STRING){
+        cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+token->first+"' may only accept NUMBER or STRING types", token);
+        return false;
+    }
 
-                    if(value->type == CV::DataType::STRING){
-                        return std::static_pointer_cast<CV::DataString>(value)->v;
-                    }
+    if(target->type != subject->type){
+        cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+token->first+"' may only mutate same types", token);
+        return false;
+    }
 
-                    return CV::DataToText(value);
-                }
+    switch(subject->type){
+        case CV::DataType::STRING: {
+            CV::CastRef<CV::DataString>(subject)->v = CV::CastRef<CV::DataString>(target)->v;
+            break;
+        };
+        case CV::DataType::NUMBER: {
+            CV::CastRef<CV::DataNumber>(subject)->v = CV::CastRef<CV::DataNumber>(target)->v;
+            break;
+        };
+    }
 
-                // unresolved placeholders are left as-is
-                return "{" + name + "}";
-            };
+    return true;
+}
 
-            auto expandTemplateString = [&](const std::string &src) -> std::string {
-                std::string out;
-                std::size_t i = 0;
+/*
+    Loops run every iteration in a context of its own. Most bodies never bind a name in it, so the one from the
+    previous iteration is handed back as long as it is still empty and nothing else holds on to it. Anything
+    else gets a fresh one: clearing a used context would have to invalidate the name caches that saw it
+*/
+static void __cv_next_iteration_context(CV::ContextType &iterCtx, const CV::ContextType &head){
+    if(iterCtx && iterCtx.use_count() == 1 && iterCtx->data.empty() && iterCtx->namedNames.empty()){
+        return;
+    }
+    iterCtx = head->buildContext(true);
+}
 
-                while(i < src.size()){
-                    if(src[i] == '{'){
-                        auto end = src.find('}', i + 1);
-                        if(end != std::string::npos){
-                            auto key = src.substr(i + 1, end - i - 1);
-
-                            if(!key.empty()){
-                                out += resolveTemplateName(key);
-                                i = end + 1;
-                                continue;
-                            }
-                        }
-                    }
+struct __cv_for_range {
+    CV::Symbol name;
+    CV_NUMBER current;
+    CV_NUMBER end;
+    CV_NUMBER step;
 
-                    out += src[i];
-                    ++i;
-                }
+    bool shouldRun(CV_NUMBER n) const {
+        return step > 0 ? (n < end) : (n > end);
+    }
+};
 
-                return out;
-            };
+// Validates the iterator clause of a 'for' like [~x [from to [step]]]
+static bool __cv_for_range_setup(
+    const CV::TokenType &token,
+    const CV::Ref<CV::Data> &clauseRaw,
+    const CV::CursorType &cursor,
+    __cv_for_range &range
+){
+    if(!clauseRaw || clauseRaw->type != CV::DataType::PROXY){
+        cursor->setError(
+            CV_ERROR_MSG_ILLEGAL_ITERATOR,
+            "'"+token->first+"' expects first operand to evaluate into a named proxy like [~x [0 10]]",
+            token
+        );
+        return false;
+    }
 
-            for(int i = 0; i < static_cast<int>(token->inner.size()); ++i){
-                auto &child = token->inner[i];
+    auto clauseProxy = CV::CastRef<CV::DataProxy>(clauseRaw);
 
-                auto data = Interpret(child, cursor, cf, templateCtx);
-                if(cursor->error){
-                    cursor->subject = token;
-                    return ctx->buildNil();
-                }
+    if(clauseProxy->pname == 0){
+        cursor->setError(
+            CV_ERROR_MSG_ILLEGAL_ITERATOR,
+            "'"+token->first+"' iterator is missing a name",
+            token
+        );
+        return false;
+    }
 
-                if(cf->state == CV::ControlFlowState::YIELD){
-                    return data;
-                }
+    if(!clauseProxy->target){
+        cursor->setError(
+            CV_ERROR_MSG_ILLEGAL_ITERATOR,
+            "'"+token->first+"' iterator proxy is missing a range target",
+            token
+        );
+        return false;
+    }
 
-                if(cf->state == CV::ControlFlowState::RETURN ||
-                   cf->state == CV::ControlFlowState::SKIP){
-                    return data;
-                }
+    range.name = clauseProxy->pname;
+    auto rangeData = clauseProxy->target->unwrap();
 
-                if(!data){
-                    continue;
-                }
+    if(!rangeData || rangeData->type != CV::DataType::LIST){
+        cursor->setError(
+            CV_ERROR_MSG_ILLEGAL_ITERATOR,
+            "'"+token->first+"' iterator target must be a LIST like [from to] or [from to step]",
+            token
+        );
+        return false;
+    }
 
-                // Named values define template-local names
-                if(data->type == CV::DataType::PROXY){
-                    auto proxy = std::static_pointer_cast<CV::DataProxy>(data);
+    auto bounds = CV::CastRef<CV::DataList>(rangeData);
 
-                    if(proxy->ptype == CV::Prefixer::NAMER && !proxy->pname.empty()){
-                        if(proxy->target){
-                            templateCtx->data[proxy->pname] = proxy->target->unwrap();
-                        }
-                    }
+    if(bounds->v.size() != 2 && bounds->v.size() != 3){
+        cursor->setError(
+            CV_ERROR_MSG_ILLEGAL_ITERATOR,
+            "'"+token->first+"' iterator target expects [from to] or [from to step]",
+            token
+        );
+        return false;
+    }
 
-                    // proxies themselves do not directly contribute to output
-                    continue;
-                }
+    auto fromData = bounds->v[0] ? bounds->v[0]->unwrap() : nullptr;
+    auto toData   = bounds->v[1] ? bounds->v[1]->unwrap() : nullptr;
 
-                auto out = data->unwrap();
-                if(!out){
-                    continue;
-                }
+    if(!fromData || fromData->type != CV::DataType::NUMBER ||
+    !toData   || toData->type   != CV::DataType::NUMBER){
+        cursor->setError(
+            CV_ERROR_MSG_ILLEGAL_ITERATOR,
+            "'"+token->first+"' bounds must be NUMBER values",
+            token
+        );
+        return false;
+    }
 
-                // Only strings are appended directly
-                if(out->type == CV::DataType::STRING){
-                    auto raw = std::static_pointer_cast<CV::DataString>(out)->v;
-                    output += expandTemplateString(raw);
-                }
-            }
+    range.current = CV::CastRef<CV::DataNumber>(fromData)->v;
+    range.end = CV::CastRef<CV::DataNumber>(toData)->v;
+    range.step = range.current <= range.end ? 1 : -1;
 
-            return std::static_pointer_cast<CV::Data>(
-                ctx->buildString(output)
+    if(bounds->v.size() == 3){
+        auto stepData = bounds->v[2] ? bounds->v[2]->unwrap() : nullptr;
+        if(!stepData || stepData->type != CV::DataType::NUMBER){
+            cursor->setError(
+                CV_ERROR_MSG_ILLEGAL_ITERATOR,
+                "'"+token->first+"' step must be NUMBER",
+                token
             );
-        }else        
-        // EXPANDER
-        if(token->first[0] == '^'){
-            if(token->inner.size() != 0){
-                cursor->setError(
-                    CV_ERROR_MSG_MISUSED_PREFIX,
-                    "Expander Prefix '"+token->first+"' expects no values",
-                    token
-                );
-                return ctx->buildNil();
-            }
+            return false;
+        }
+        range.step = CV::CastRef<CV::DataNumber>(stepData)->v;
+    }
 
-            if(token->first.size() == 1){
-                cursor->setError(
-                    CV_ERROR_MSG_MISUSED_PREFIX,
-                    "Expander Prefix '"+token->first+"' expects an appended body",
-                    token
-                );
-                return ctx->buildNil();
-            }
+    if(range.step == 0){
+        cursor->setError(
+            CV_ERROR_MSG_ILLEGAL_ITERATOR,
+            "'"+token->first+"' step cannot be zero",
+            token
+        );
+        return false;
+    }
 
-            std::string statement = std::string(token->first.begin() + 1, token->first.end());
+    return true;
+}
 
-            auto root = CV::BuildTree(statement, cursor);
-            if(cursor->error){
-                cursor->subject = token;
-                return ctx->buildNil();
-            }
+/*
+    Binds the arguments of a function call as they get evaluated. Arguments named through a proxy keep their
+    name, everything else takes the next free parameter (or 'arg-N' for variadic functions).
+
+    User functions with parameters bind into one slot per parameter through the function's paramIndex, so a
+    plain positional argument never builds a name. Only the arguments that don't land on a parameter go to
+    'params' with a name. Variadic user functions only keep values and lambdas get every name as before
+*/
+struct __cv_call_binding {
+    CV::Ref<CV::DataFunction> fn;
+    std::vector<std::pair<std::string, CV::Ref<CV::Data>>> params;
+    std::vector<CV::Ref<CV::Data>> slots;
+    bool slotted;
+    // Set once a name other than 'arg-N' was handed out. Until then fallback names can't collide
+    bool named;
+    int positionalCursor;
+    // Leading number arguments the VM holds back inline while the call can still go through fn->kernel
+    CV::Value held[4];
+    int heldCount;
+    bool holding;
+
+    __cv_call_binding(const CV::Ref<CV::DataFunction> &fn){
+        this->fn = fn;
+        this->slotted = !fn->isLambda && !fn->isVariadic;
+        this->named = !fn->params.empty();
+        this->positionalCursor = 0;
+        this->heldCount = 0;
+        this->holding = fn->kernel != NULL;
+        if(this->slotted){
+            this->slots.resize(fn->params.size());
+        }
+    }
 
-            if(root.size() != 1){
-                cursor->setError(
-                    CV_ERROR_MSG_MISUSED_PREFIX,
-                    "Expander Prefix '"+token->first+"' apppended body must a singular LIST",
-                    token
-                );
-                return ctx->buildNil();                
+    bool hold(const CV::Value &v){
+        if(!holding || v.type != CV::DataType::NUMBER || heldCount == 4){
+            return false;
+        }
+        held[heldCount++] = v;
+        return true;
+    }
+
+    // Binds the held back arguments, the call goes on as a regular one
+    void release(){
+        for(int i = 0; i < heldCount; ++i){
+            auto boxed = held[i].box();
+            bind(boxed, boxed, i);
+        }
+        heldCount = 0;
+        holding = false;
+    }
+
+    bool runKernel(CV_NUMBER &out){
+        if(!holding){
+            return false;
+        }
+        CV_NUMBER numbers[4];
+        for(int i = 0; i < heldCount; ++i){
+            numbers[i] = held[i].toNumber();
+        }
+        return fn->kernel(numbers, heldCount, out);
+    }
+
+    bool isUsed(CV::Symbol name){
+        if(slotted){
+            auto it = fn->paramIndex.find(name);
+            if(it != fn->paramIndex.end()){
+                return slots[it->second] != nullptr;
             }
+        }
+        return CV::Tools::isInList(CV::SymbolName(name), params);
+    }
 
-            auto result = CV::Interpret(root[0], cursor, cf, ctx);
-            if(cursor->error){
-                cursor->subject = token;
-                return ctx->buildNil();
+    void bindPositional(const CV::Ref<CV::Data> &value, int outerIndex, int innerIndex){
+        int total = fn->params.size();
+        if(slotted){
+            while(positionalCursor < total && slots[positionalCursor]){
+                ++positionalCursor;
             }
-            if(cf->state != CV::ControlFlowState::CONTINUE){
-                return result;
+            if(positionalCursor < total){
+                slots[positionalCursor++] = value;
+                return;
             }
-            result = result->unwrap();
-            if(result->type != CV::DataType::LIST){
-                cursor->setError(
-                    CV_ERROR_MSG_MISUSED_PREFIX,
-                    "Expander Prefix '"+token->first+"' apppended body must a singular LIST",
-                    token
-                );
-                return ctx->buildNil();                   
+        }else
+        if(!fn->isVariadic){
+            while(positionalCursor < total && isUsed(fn->params[positionalCursor])){
+                ++positionalCursor;
             }
-
-            auto proxy = std::make_shared<CV::DataProxy>();
-            proxy->ptype = CV::Prefixer::EXPANDER;
-            proxy->target = result;
-
-            return std::static_pointer_cast<CV::Data>(proxy);
-        }else        
-        /*
-            NAMER
-        */
-        if(token->first[0] == '~'){
-            auto name = std::string(token->first.begin() + 1, token->first.end());
-
-            // Test if the first field (name) is a complex token
-            auto testSplit = ParseTokens(name, ' ', cursor, token->line);
-            if(cursor->error){
-                return ctx->buildNil();
+            if(positionalCursor < total){
+                params.push_back({CV::SymbolName(fn->params[positionalCursor++]), value});
+                return;
             }
+        }else
+        if(!fn->isLambda){
+            // Its body only gets to see the values through '@'
+            params.push_back({std::string(), value});
+            return;
+        }
 
-            if(testSplit.size() > 1){
-                cursor->setError(
-                    CV_ERROR_MSG_MISUSED_PREFIX,
-                    "Namer Prefix '"+token->first+"' cannot take any complex token",
-                    token
-                );
-                return ctx->buildNil();
-            }
+        std::string fallback = "arg-" + std::to_string(outerIndex);
+        if(innerIndex >= 0){
+            fallback += "-" + std::to_string(innerIndex);
+        }
 
-            // Is it a valid name?
-            if(!CV::Tools::isValidVarName(name)){
-                cursor->setError(
-                    CV_ERROR_MSG_MISUSED_PREFIX,
-                    "'"+token->first+"' prefixer '"+name+"' is an invalid name",
-                    token
-                );
-                return ctx->buildNil();
+        std::string picked = fallback;
+        if(named){
+            int suffix = 1;
+            while(isUsed(CV::Intern(picked))){
+                picked = fallback + "-" + std::to_string(suffix++);
             }
+        }
 
-            // Is it a reserved word?
-            if(CV::Tools::isReservedWord(name)){
-                cursor->setError(
-                    CV_ERROR_MSG_MISUSED_PREFIX,
-                    "'"+token->first+"' prefixer '"+name+"' is a name of native constructor which cannot be overriden",
-                    token
-                );
-                return ctx->buildNil();
-            }
+        params.push_back({picked, value});
+    }
 
-            // Only expects a single value
-            if(token->inner.size() > 1){
-                cursor->setError(
-                    CV_ERROR_MSG_MISUSED_PREFIX,
-                    "Namer Prefix '"+token->first+"' no more than 1 value. Provided "+std::to_string(token->inner.size()),
-                    token
-                );
-                return ctx->buildNil();
+    void bind(const CV::Ref<CV::Data> &raw, const CV::Ref<CV::Data> &value, int outerIndex, int innerIndex = -1){
+        if(raw && raw->type == CV::DataType::PROXY){
+            auto proxy = static_cast<CV::DataProxy*>(raw.get());
+
+            if(proxy->ptype != CV::Prefixer::EXPANDER && proxy->pname != 0 && !isUsed(proxy->pname)){
+                named = true;
+                if(slotted){
+                    auto it = fn->paramIndex.find(proxy->pname);
+                    if(it != fn->paramIndex.end()){
+                        slots[it->second] = value;
+                        return;
+                    }
+                }
+                params.push_back({CV::SymbolName(proxy->pname), value});
+                return;
             }
+        }
 
-            auto proxy = std::make_shared<CV::DataProxy>();
-            proxy->ptype = CV::Prefixer::NAMER;
-            proxy->pname = name;
+        bindPositional(value, outerIndex, innerIndex);
+    }
 
+    // Binds the evaluated argument 'index' coming from token 'c'
+    bool push(
+        const CV::Ref<CV::Data> &first,
+        int index,
+        const CV::TokenType &c,
+        const CV::ContextType &fnCtx,
+        const CV::CursorType &cursor
+    ){
+        if(first && first->type == CV::DataType::PROXY){
+            auto proxy = CV::CastRef<CV::DataProxy>(first);
+
+            if(proxy->ptype == CV::Prefixer::EXPANDER){
+                if(!proxy->target){
+                    cursor->setError(
+                        CV_ERROR_MSG_MISUSED_PREFIX,
+                        "Expander Prefix '^' produced a proxy without target",
+                        c
+                    );
+                    return false;
+                }
 
-            // Evaluate referred value if present
-            if(token->inner.size() == 1){
-                auto target = Interpret(token->inner[0], cursor, cf, ctx);
-                if(cursor->error){
-                    cursor->subject = token;
-                    return ctx->buildNil();
+                auto expanded = proxy->target->unwrap();
+                if(!expanded || expanded->type != CV::DataType::LIST){
+                    cursor->setError(
+                        CV_ERROR_MSG_MISUSED_PREFIX,
+                        "Expander Prefix '^' expects target to resolve into a LIST",
+                        c
+                    );
+                    return false;
                 }
 
-                if(cf->state != CV::ControlFlowState::CONTINUE){
-                    return target;
+                auto list = CV::CastRef<CV::DataList>(expanded);
+
+                for(int j = 0; j < static_cast<int>(list->v.size()); ++j){
+                    auto &memberRaw = list->v[j];
+                    bind(memberRaw, memberRaw ? memberRaw->unwrap() : fnCtx->buildNil(), index, j);
                 }
 
-                proxy->target = target;
+                return true;
             }
+        }
 
-            // Name into context if the name is not used
-            if(proxy->target){
-                auto exists = ctx->getNamed(name);
-                if(!exists.first && !exists.second){
-                    ctx->data[name] = proxy->target;
-                    ctx->namedNames.insert(name);
+        bind(first, first ? first->unwrap() : fnCtx->buildNil(), index);
+
+        return true;
+    }
+
+    // Check for missing names
+    bool complete(const std::string &qname, const CV::TokenType &token, const CV::CursorType &cursor){
+        if(!fn->isVariadic){
+            for(int i = 0; i < fn->params.size(); ++i){
+                if(slotted ? !slots[i] : !CV::Tools::isInList(CV::SymbolName(fn->params[i]), params)){
+                    cursor->setError(
+                        CV_ERROR_MSG_WRONG_OPERANDS,
+                        CV::Tools::format(
+                            "Function '%s' is expecting param '%s' which wasn't provided",
+                            qname.c_str(),
+                            CV::SymbolName(fn->params[i]).c_str()
+                        ),
+                        token
+                    );
+                    return false;
                 }
             }
+        }
+        return true;
+    }
 
-            return std::static_pointer_cast<CV::Data>(proxy);
-        }else                                              
-        /*
-            NIL
-        */
-        if(token->first == "nil"){
-            if(token->inner.size() > 0){
-                return bListConstructFromToken(token, ctx);
-            }else{
-                return ctx->buildNil();
-            } 
-        }else
-        /*
-            NUMBER
-        */
-        if(CV::Tools::isNumber(token->first)){
-            if(token->inner.size() > 0){
-                return bListConstructFromToken(token, ctx);
-            }else{
-                return ctx->buildNumber(std::stod(token->first));
-            }
-        }else
-        /*
-            STRING
-        */
-        if(CV::Tools::isString(token->first)){
-            if(token->inner.size() > 0){
-                return bListConstructFromToken(token, ctx);
-            }else{            
-                return ctx->buildString(token->first.substr(1, token->first.length() - 2));
+    // Context the body of a non-lambda function runs in
+    CV::ContextType buildBodyContext(const CV::ContextType &fnCtx){
+        auto paramCtx = fnCtx->buildContext(true);
+        if(fn->isVariadic){
+            auto list = paramCtx->buildList();
+            static const CV::Symbol variadic = CV::Intern("@");
+            paramCtx->setNamed(variadic, list);
+            for(int i = 0; i < params.size(); ++i){
+                list->v.push_back(__cv_unshared(params[i].second));
             }
         }else{
-            /*
-                IS NAME?        
-            */   
-            auto hctx = ctx;
-            std::string qname = token->first;
-            auto nameRef = ctx->getNamed(qname);
-            if(nameRef.first && nameRef.second){
-                auto &data = nameRef.second;
+            for(int i = 0; i < static_cast<int>(slots.size()); ++i){
+                paramCtx->setNamed(fn->params[i], slots[i]);
+            }
+            for(int i = 0; i < params.size(); ++i){
+                auto &a = params[i];
+                paramCtx->setNamed(a.first, a.second);
+            }
+        }
+        return paramCtx;
+    }
+};
 
-                switch(data->type){
-                    case CV::DataType::FUNCTION: {
-                        auto fn = std::static_pointer_cast<CV::DataFunction>(data);
+CV::Ref<CV::Data> CV::Interpret(
+    const CV::TokenType &token,
+    const CV::CursorType &cursor,
+    const CV::ControlFlowType &cf,
+    const CV::ContextType &ctx
+){
+    if(token->first.size() == 0 && token->inner.size() == 0){
+        cursor->setError("NOOP", CV_ERROR_MSG_NOOP_NO_INSTRUCTIONS, token);
+        return ctx->buildNil();
+    }
 
-                        auto fnCtx = ctx->buildContext(true);
+    auto bListConstruct = [cursor, cf](const CV::TokenType &origin, std::vector<CV::TokenType> &tokens, const CV::ContextType &ctx, const CV::Ref<CV::Data> &head){
+        auto list = ctx->buildList();
+        if(head && !__cv_list_append(list, head, origin, origin, cursor, ctx)){
+            return ctx->buildNil();
+        }
 
-                        std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> allParams;
+        for(int i = 0; i < static_cast<int>(tokens.size()); ++i){
+            auto &inc = tokens[i];
 
+            auto data = Interpret(inc, cursor, cf, ctx);
+            if(cursor->error){
+                cursor->subject = origin;
+                return ctx->buildNil();
+            }
 
-                        std::vector<std::string> usedNames;
-                        int positionalCursor = 0;
+            if(cf->state == CV::ControlFlowState::YIELD){
+                return data;
+            }
 
-                        auto nextPositionalName = [&](int outerIndex, int innerIndex = -1) -> std::string {
-                            if(!fn->isVariadic){
-                                while(
-                                    positionalCursor < static_cast<int>(fn->params.size()) &&
-                                    CV::Tools::isInList(fn->params[positionalCursor], usedNames)
-                                ){
-                                    ++positionalCursor;
-                                }
+            if(cf->state == CV::ControlFlowState::RETURN ||
+            cf->state == CV::ControlFlowState::SKIP){
+                return data;
+            }
 
-                                if(positionalCursor < static_cast<int>(fn->params.size())){
-                                    auto picked = fn->params[positionalCursor++];
-                                    usedNames.push_back(picked);
-                                    return picked;
-                                }
-                            }
+            if(!__cv_list_append(list, data, inc, origin, cursor, ctx)){
+                return ctx->buildNil();
+            }
+        }
 
-                            std::string fallback =
-                                innerIndex >= 0
-                                    ? CV::Tools::format("arg-%i-%i", outerIndex, innerIndex)
-                                    : CV::Tools::format("arg-%i", outerIndex);
+        return CV::CastRef<CV::Data>(list);
+    };
 
-                            std::string picked = fallback;
-                            int suffix = 1;
-                            while(CV::Tools::isInList(picked, usedNames)){
-                                picked = fallback + "-" + std::to_string(suffix++);
-                            }
 
-                            usedNames.push_back(picked);
-                            return picked;
-                        };
+    auto bStoreConstruct = [cursor, cf](const std::string &name, const CV::TokenType &origin, std::vector<CV::TokenType> &tokens, const CV::ContextType &ctx){
+        auto store = ctx->buildStore();
+        for(int i = 0; i < tokens.size(); ++i){
+            auto &inc = tokens[i];
+            auto fetched = Interpret(inc, cursor, cf, ctx);
+            if(cursor->error){
+                cursor->subject = origin;
+                return ctx->buildNil();
+            }
+            if(cf->state == CV::ControlFlowState::YIELD){
+                return fetched;
+            }
+            if(fetched->type != CV::DataType::PROXY){
+                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+name+"' may only be able to construct named types using NAMER prefixer", origin);
+                return ctx->buildNil();
+            }
+            auto proxy = CV::CastRef<CV::DataProxy>(fetched);
+            // We eat up the instruction itself as we don't really execute it for this situation
+            if(!proxy->target){
+                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+name+"' expects Namer prefixed tokens to have an appended body so it defines a value", origin);
+                return ctx->buildNil();
+            }
+            
+            auto &vname = CV::SymbolName(proxy->pname);
+            if(!CV::Tools::isValidVarName(vname)){
+                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+name+"' is attempting to construct store with invalidly named type '"+vname+"'", origin);
+                return ctx->buildNil();
+            }
+            if(CV::Tools::isReservedWord(vname)){
+                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+name+"' is attempting to construct store with reserved name named type '"+vname+"'", origin);
+                return ctx->buildNil();               
+            }
+            store->v.set(vname, proxy->target);
+        }
+        return CV::CastRef<CV::Data>(store);
+    };    
 
-                        auto inferParamName = [&](const std::shared_ptr<CV::Data> &raw, int outerIndex, int innerIndex = -1) -> std::string {
-                            if(raw && raw->type == CV::DataType::PROXY){
-                                auto proxy = std::static_pointer_cast<CV::DataProxy>(raw);
+    // Lists like [1 2 3] or [x 1] keep their first item as the token itself, callers hand it over already built or looked up
+    auto bListConstructFromToken = [bListConstruct](const CV::TokenType &origin, const CV::ContextType &ctx, const CV::Ref<CV::Data> &head){
+        return bListConstruct(origin, origin->inner, ctx, head);
+    };
 
-                                if(proxy->ptype != CV::Prefixer::EXPANDER && !proxy->pname.empty()){
-                                    std::string picked = proxy->pname;
+    switch(token->opcode){
+        /*
+            INSTRUCTION LIST
+        */
+        case CV::Opcode::GROUP: {
+            if(__cv_are_all_functions(token, ctx) && token->inner.size() >= 2){
+                return Interpret(token, cursor, cf, ctx);
+            }else
+            if(__cv_are_all_names(token)){
+                return bStoreConstruct(token->first, token, token->inner, ctx);
+            }else{
+            // Or list?
+                return bListConstruct(token, token->inner, ctx, nullptr);
+            }
+        };
+        /*
+            b:store
+        */
+        case CV::Opcode::B_STORE: {
+            return bStoreConstruct(token->first, token, token->inner, ctx);
+        };
+        /*
+            b:list
+        */
+        case CV::Opcode::B_LIST: {
+            return bListConstruct(token, token->inner, ctx, nullptr);
+        };
+        /*
+            SKIP / RETURN / YIELD
+        */
+        case CV::Opcode::SKIP:
+        case CV::Opcode::RETURN:
+        case CV::Opcode::YIELD: {
+            if(token->inner.size() > 1){
+                cursor->setError(CV_ERROR_MSG_MISUSED_IMPERATIVE, "'"+token->first+"' expects no more than 1 operand ("+token->first+" VALUE)", token);
+                return ctx->buildNil();
+            }
+            
+            int type = CV::ControlFlowState::CONTINUE;
+            if(token->opcode == CV::Opcode::SKIP){
+                type = CV::ControlFlowState::SKIP;
+            }else
+            if(token->opcode == CV::Opcode::YIELD){
+                type = CV::ControlFlowState::YIELD;
+            }else
+            if(token->opcode == CV::Opcode::RETURN){
+                type = CV::ControlFlowState::RETURN;
+            }
 
-                                    if(!CV::Tools::isInList(picked, usedNames)){
-                                        usedNames.push_back(picked);
-                                        return picked;
-                                    }
-                                }
-                            }
+            auto r = ctx->buildNil();
+            cf->state = type;
 
-                            return nextPositionalName(outerIndex, innerIndex);
-                        };
+            if(token->inner.size() > 0){
+                r = Interpret(token->inner[0], cursor, cf, ctx);
+                if(cursor->error){
+                    cursor->subject = token;
+                    return ctx->buildNil();
+                }
+            }
 
-                        for(int i = 0; i < static_cast<int>(token->inner.size()); ++i){
-                            auto &c = token->inner[i];
+            return r;
+        };
+        /*
+            FN
+        */
+        case CV::Opcode::FN: {
+            if(token->inner.size() != 2){
+                cursor->setError(CV_ERROR_MSG_MISUSED_IMPERATIVE, "'"+token->first+"' expects exactly 3 tokens ("+token->first+" [arguments][code])", token);
+                return ctx->buildNil();
+            }
+            auto fn = CV::MakeRef<CV::DataFunction>();
+            fn->isLambda = false;
+            fn->body = token->inner[1];
 
-                            auto first = Interpret(c, cursor, cf, fnCtx);
-                            if(cursor->error){
-                                cursor->subject = c;
-                                return ctx->buildNil();
-                            }
+            auto paramNameList = token->inner[0]->inner;
+            paramNameList.insert(paramNameList.begin(), token->inner[0]);
 
-                            if(cf->state == CV::ControlFlowState::YIELD){
-                                return first;
-                            }
+            auto hasParam = [&](CV::Symbol name){
+                for(const auto &p : fn->params){
+                    if(p == name){
+                        return true;
+                    }
+                }
+                return false;
+            };
 
-                            if(cf->state == CV::ControlFlowState::RETURN ||
-                            cf->state == CV::ControlFlowState::SKIP){
-                                return first;
-                            }
+            if(paramNameList.size() == 1 && paramNameList[0]->first == "@"){
+                fn->isVariadic = true;
+            }else{
+                for(int i = 0; i < paramNameList.size(); ++i){
+                    auto &name = paramNameList[i]->first;
+                    auto symbol = __cv_token_symbol(paramNameList[i]);
+                    if(!CV::Tools::isValidVarName(name)){
+                        cursor->setError(CV_ERROR_MSG_MISUSED_IMPERATIVE, "'"+token->first+"' argument name '"+name+"' is an invalid", token);
+                        return ctx->buildNil();                 
+                    }
+                    if(CV::Tools::isReservedWord(name)){
+                        cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+token->first+"' argument name '"+name+"' is a name of native constructor which cannot be overriden", token);
+                        return ctx->buildNil();
+                    }  
+                    if(hasParam(symbol)){
+                        cursor->setError(
+                            CV_ERROR_MSG_MISUSED_IMPERATIVE,
+                            "'"+token->first+"' argument name '"+name+"' is duplicated",
+                            token
+                        );
+                        return ctx->buildNil();
+                    }                    
+                    if(name == "@"){
+                        cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+token->first+"' argument name '"+name+"' is illegal in definitions with more than one argument", token);
+                        return ctx->buildNil();                 
+                    }
+                    fn->params.push_back(symbol);
+                }
+            }
+            fn->plan();
 
-                            if(first && first->type == CV::DataType::PROXY){
-                                auto proxy = std::static_pointer_cast<CV::DataProxy>(first);
-
-                                if(proxy->ptype == CV::Prefixer::EXPANDER){
-                                    if(!proxy->target){
-                                        cursor->setError(
-                                            CV_ERROR_MSG_MISUSED_PREFIX,
-                                            "Expander Prefix '^' produced a proxy without target",
-                                            c
-                                        );
-                                        return ctx->buildNil();
-                                    }
-
-                                    auto expanded = proxy->target->unwrap();
-                                    if(!expanded || expanded->type != CV::DataType::LIST){
-                                        cursor->setError(
-                                            CV_ERROR_MSG_MISUSED_PREFIX,
-                                            "Expander Prefix '^' expects target to resolve into a LIST",
-                                            c
-                                        );
-                                        return ctx->buildNil();
-                                    }
-
-                                    auto list = std::static_pointer_cast<CV::DataList>(expanded);
-
-                                    for(int j = 0; j < static_cast<int>(list->v.size()); ++j){
-                                        auto &memberRaw = list->v[j];
-                                        auto memberOut = memberRaw ? memberRaw->unwrap() : fnCtx->buildNil();
-
-                                        std::string pickedName = inferParamName(memberRaw, i, j);
-
-                                        allParams.push_back({
-                                            pickedName,
-                                            memberOut
-                                        });
-                                    }
-
-                                    continue;
-                                }
-                            }
+            return fn;
+            
+        };
+        /*
+            CC
+        */
+        case CV::Opcode::CC: {
+            if(token->inner.size() != 1){
+                cursor->setError(
+                    CV_ERROR_MSG_MISUSED_IMPERATIVE,
+                    "'"+token->first+"' expects exactly 2 tokens ("+token->first+" VALUE)",
+                    token
+                );  
+                return ctx->buildNil();
+            }
 
-                            auto out = first ? first->unwrap() : fnCtx->buildNil();
-                            std::string pickedName = inferParamName(first, i);
+            auto target = Interpret(token->inner[0], cursor, cf, ctx);
+            if(cursor->error){
+                cursor->subject = token;
+                return ctx->buildNil();
+            }
+            if(cf->state == CV::ControlFlowState::YIELD){
+                return target;
+            }            
 
-                            allParams.push_back({
-                                pickedName,
-                                out
-                            });
-                        }
+            return ctx->copy(target->unwrap());
+        };
+        /*
+            MUT
+        */
+        case CV::Opcode::MUT: {
+            if(token->inner.size() != 2){
+                cursor->setError(CV_ERROR_MSG_MISUSED_IMPERATIVE, "'"+token->first+"' expects exactly 3 tokens ("+token->first+" NAME VALUE)", token);
+                return ctx->buildNil();
+            }
+            
+            auto named = __cv_lookup_mutable_name(token->inner[0], ctx.get());
+            if(!named || !*named){
+                cursor->setError(CV_ERROR_MSG_UNDEFINED_IMPERATIVE, "Name '"+token->first+"'", token);
+                return ctx->buildNil();
+            }
+            auto subject = __cv_mutable_subject(*named);
 
+            auto target = Interpret(token->inner[1], cursor, cf, ctx);
+            if(cursor->error){
+                cursor->subject = token;
+                return ctx->buildNil();
+            } 
+            if(cf->state == CV::ControlFlowState::YIELD){
+                return target;
+            }     
+            if(!__cv_mutate(subject, target->unwrap(), token, cursor)){
+                return ctx->buildNil();
+            }
 
-                        // Check for missing names
-                        if(!fn->isVariadic){
-                            for(int i = 0; i < fn->params.size(); ++i){
-                                if(!CV::Tools::isInList(fn->params[i], allParams)){
-                                    cursor->setError(
-                                        CV_ERROR_MSG_WRONG_OPERANDS,
-                                        CV::Tools::format(
-                                            "Function '%s' is expecting param '%s' which wasn't provided",
-                                            qname.c_str(),
-                                            fn->params[i].c_str()
-                                        ),
-                                        token
-                                    );
-                                    return ctx->buildNil();                                    
-                                }
-                            }
-                        }
+            return subject;
+        };
+        /*
+            IMPORT
+        */
+        case CV::Opcode::IMPORT: {
+            if(token->inner.size() != 1){
+                cursor->setError(
+                    CV_ERROR_MSG_MISUSED_IMPERATIVE,
+                    "'"+token->first+"' expects exactly 2 tokens ("+token->first+" NAME)",
+                    token
+                );
+                return ctx->buildNil();
+            }
 
-                        if(fn->isLambda){
-                            auto r = fn->lambda(allParams, fnCtx, cursor, token);
-                            if(cursor->error){
-                                cursor->subject = token;
-                                return ctx->buildNil();
-                            }
-                            return r;
+            auto fnamev = Interpret(token->inner[0], cursor, cf, ctx);
+            if(cursor->error){
+                cursor->subject = token;
+                return ctx->buildNil();
+            }
+            if(cf->state == CV::ControlFlowState::YIELD){
+                return fnamev;
+            }
+
+            fnamev = fnamev ? fnamev->unwrap() : nullptr;
+
+            if(!fnamev || fnamev->type != CV::DataType::STRING){
+                cursor->setError(
+                    CV_ERROR_MSG_LIBRARY_NOT_VALID,
+                    "'"+token->first+"' expects a STRING operand",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            auto fname = CV::CastRef<CV::DataString>(fnamev)->v;
+            auto resolved = __cv_resolve_import_path(fname, ".cv");
+
+            if(!CV::Tools::fileExists(resolved)){
+                cursor->setError(
+                    CV_ERROR_MSG_LIBRARY_NOT_VALID,
+                    "No canvas library '"+resolved+"' was found",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            auto result = CV::Import(resolved, ctx, cursor);
+            if(cursor->error){
+                cursor->subject = token;
+                return ctx->buildNil();
+            }
+
+            return result ? result : ctx->buildNil();
+        };
+        /*
+            IMPORT:DYNAMIC-LIBRARY
+        */
+        case CV::Opcode::IMPORT_DYNAMIC_LIBRARY: {
+            if(token->inner.size() != 1){
+                cursor->setError(
+                    CV_ERROR_MSG_MISUSED_IMPERATIVE,
+                    "'"+token->first+"' expects exactly 2 tokens ("+token->first+" NAME)",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            auto fnamev = Interpret(token->inner[0], cursor, cf, ctx);
+            if(cursor->error){
+                cursor->subject = token;
+                return ctx->buildNil();
+            }
+            if(cf->state == CV::ControlFlowState::YIELD){
+                return fnamev;
+            }
+
+            fnamev = fnamev ? fnamev->unwrap() : nullptr;
+
+            if(!fnamev || fnamev->type != CV::DataType::STRING){
+                cursor->setError(
+                    CV_ERROR_MSG_LIBRARY_NOT_VALID,
+                    "'"+token->first+"' expects a STRING operand",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            auto fname = CV::CastRef<CV::DataString>(fnamev)->v;
+
+            std::string ext = ".so";
+            if(CV::PLATFORM == CV::SupportedPlatform::WINDOWS){
+                ext = ".dll";
+            }else
+            if(CV::PLATFORM == CV::SupportedPlatform::OSX){
+                ext = ".dylib";
+            }
+
+            auto resolved = __cv_resolve_import_path(fname, ext);
+
+            if(!CV::Tools::fileExists(resolved)){
+                cursor->setError(
+                    CV_ERROR_MSG_LIBRARY_NOT_VALID,
+                    "No dynamic library '"+resolved+"' was found",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            auto result = CV::ImportDynamicLibrary(resolved, fname, ctx, cursor);
+            if(cursor->error){
+                cursor->subject = token;
+                return ctx->buildNil();
+            }
+
+            return result ? result : ctx->buildNil();
+        };
+        /*
+            LET
+        */
+        case CV::Opcode::LET: {
+            if(token->inner.size() != 2){
+                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+token->first+"' expects exactly 3 tokens ("+token->first+" NAME VALUE)", token);
+                return ctx->buildNil();
+            }
+
+            auto &nameToken = token->inner[0];
+            auto &insToken = token->inner[1];
+
+            if(nameToken->inner.size() != 0){
+                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+token->first+"' expects NAME as second operand", token);
+                return ctx->buildNil();             
+            }
+            auto &name = nameToken->first;
+            if(!CV::Tools::isValidVarName(name)){
+                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+token->first+"' second operand '"+name+"' is an invalid name", token);
+                return ctx->buildNil();
+            }
+            if(CV::Tools::isReservedWord(name)){
+                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "'"+token->first+"' second operand '"+name+"' is a name of native constructor which cannot be overriden", token);
+                return ctx->buildNil();
+            }            
+
+            auto symbol = __cv_token_symbol(nameToken);
+            auto nameRef = ctx->getNamed(symbol);
+            if(nameRef.first && nameRef.second && ctx->namedNames.count(symbol) == 0){
+                cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "Name '"+name+"' is already defined", token);
+                return ctx->buildNil();
+            }
+
+            auto target = Interpret(insToken, cursor, cf, ctx);
+            if(cursor->error){
+                cursor->subject = token;
+                return ctx->buildNil();
+            }
+            if(cf->state == CV::ControlFlowState::YIELD){
+                return target;
+            }                             
+
+            auto &bound = ctx->setNamed(symbol, target);
+            if(ctx->namedNames.count(symbol) == 1){
+                ctx->namedNames.erase(symbol);
+            }
+
+            return bound;
+
+        };
+        /*
+            IF
+        */
+        case CV::Opcode::IF: {
+            if(token->inner.size() != 2 && token->inner.size() != 3){
+                cursor->setError(
+                    CV_ERROR_MSG_MISUSED_IMPERATIVE,
+                    "'"+token->first+"' expects 3 or 4 tokens ("+token->first+" CONDITION TRUE-BRANCH [FALSE-BRANCH])",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            auto condition = Interpret(token->inner[0], cursor, cf, ctx);
+            if(cursor->error){
+                cursor->subject = token;
+                return ctx->buildNil();
+            }
+
+            if(cf->state == CV::ControlFlowState::YIELD){
+                return condition;
+            }
+
+            if(cf->state == CV::ControlFlowState::RETURN ||
+               cf->state == CV::ControlFlowState::SKIP){
+                return condition;
+            }
+
+            if(__cv_get_boolean_value(condition)){
+                return Interpret(token->inner[1], cursor, cf, ctx);
+            }
+
+            if(token->inner.size() == 3){
+                return Interpret(token->inner[2], cursor, cf, ctx);
+            }
+
+            return ctx->buildNil();
+        };
+        /*
+            WHILE
+        */
+        case CV::Opcode::WHILE: {
+            if(token->inner.size() < 2){
+                cursor->setError(
+                    CV_ERROR_MSG_MISUSED_IMPERATIVE,
+                    "'"+token->first+"' expects at least 3 tokens ("+token->first+" CONDITION BODY...)",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            auto result = ctx->buildNil();
+            CV::ContextType iterCtx;
+
+            while(true){
+                __cv_next_iteration_context(iterCtx, ctx);
+
+                auto condition = Interpret(token->inner[0], cursor, cf, iterCtx);
+                if(cursor->error){
+                    cursor->subject = token;
+                    return ctx->buildNil();
+                }
+
+                if(cf->state == CV::ControlFlowState::RETURN){
+                    return condition;
+                }
+
+                if(cf->state == CV::ControlFlowState::YIELD){
+                    return condition;
+                }
+
+                if(cf->state == CV::ControlFlowState::SKIP){
+                    cf->state = CV::ControlFlowState::CONTINUE;
+                    continue;
+                }
+
+                if(!__cv_get_boolean_value(condition)){
+                    break;
+                }
+
+                result = __cv_run_children(token, 1, cursor, cf, iterCtx);
+                if(cursor->error){
+                    cursor->subject = token;
+                    return ctx->buildNil();
+                }
+
+                if(cf->state == CV::ControlFlowState::RETURN){
+                    return result;
+                }
+
+                if(cf->state == CV::ControlFlowState::YIELD){
+                    return result;
+                }
+
+                if(cf->state == CV::ControlFlowState::SKIP){
+                    cf->state = CV::ControlFlowState::CONTINUE;
+                    continue;
+                }
+            }
+
+            return result;
+        };
+        /*
+            FOR
+        */
+        case CV::Opcode::FOR: {
+            if(token->inner.size() < 2){
+                cursor->setError(
+                    CV_ERROR_MSG_MISUSED_IMPERATIVE,
+                    "'"+token->first+"' expects at least 3 tokens ("+token->first+" [~name [from to [step]]] BODY...)",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            auto clauseRaw = Interpret(token->inner[0], cursor, cf, ctx);
+            if(cursor->error){
+                cursor->subject = token;
+                return ctx->buildNil();
+            }
+            if(cf->state == CV::ControlFlowState::YIELD){
+                return clauseRaw;
+            }
+
+            __cv_for_range range;
+            if(!__cv_for_range_setup(token, clauseRaw, cursor, range)){
+                return ctx->buildNil();
+            }
+
+            auto loopCtx = ctx->buildContext(true);
+            auto iterValue = loopCtx->buildNumber(range.current);
+            loopCtx->setNamed(range.name, iterValue);
+
+            auto result = ctx->buildNil();
+            CV::ContextType iterCtx;
+
+            while(range.shouldRun(iterValue->v)){
+                __cv_next_iteration_context(iterCtx, loopCtx);
+
+                for(int i = 1; i < static_cast<int>(token->inner.size()); ++i){
+                    result = Interpret(token->inner[i], cursor, cf, iterCtx);
+                    if(cursor->error){
+                        cursor->subject = token;
+                        return ctx->buildNil();
+                    }
+
+                    if(cf->state == CV::ControlFlowState::RETURN){
+                        return result;
+                    }
+
+                    if(cf->state == CV::ControlFlowState::YIELD){
+                        return result;
+                    }
+
+                    if(cf->state == CV::ControlFlowState::SKIP){
+                        cf->state = CV::ControlFlowState::CONTINUE;
+                        break;
+                    }
+                }
+
+                iterValue->v += range.step;
+            }
+
+            return result;
+        };
+        /*
+            FOREACH
+        */
+        case CV::Opcode::FOREACH: {
+            if(token->inner.size() < 2){
+                cursor->setError(
+                    CV_ERROR_MSG_MISUSED_IMPERATIVE,
+                    "'"+token->first+"' expects at least 3 tokens ("+token->first+" [~item SUBJECT] BODY...)",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            auto clauseRaw = Interpret(token->inner[0], cursor, cf, ctx);
+            if(cursor->error){
+                cursor->subject = token;
+                return ctx->buildNil();
+            }
+            if(cf->state == CV::ControlFlowState::YIELD){
+                return clauseRaw;
+            }
+
+            if(!clauseRaw || clauseRaw->type != CV::DataType::PROXY){
+                cursor->setError(
+                    CV_ERROR_MSG_ILLEGAL_ITERATOR,
+                    "'"+token->first+"' expects first operand to evaluate into a named proxy like [~item someList]",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            auto clauseProxy = CV::CastRef<CV::DataProxy>(clauseRaw);
+
+            if(clauseProxy->pname == 0){
+                cursor->setError(
+                    CV_ERROR_MSG_ILLEGAL_ITERATOR,
+                    "'"+token->first+"' iterator is missing a name",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            if(!clauseProxy->target){
+                cursor->setError(
+                    CV_ERROR_MSG_ILLEGAL_ITERATOR,
+                    "'"+token->first+"' iterator proxy is missing a subject target",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            auto iterName = clauseProxy->pname;
+            auto subject = clauseProxy->target->unwrap();
+
+            std::vector<CV::Ref<CV::Data>> values;
+
+            if(!subject){
+                cursor->setError(
+                    CV_ERROR_MSG_ILLEGAL_ITERATOR,
+                    "'"+token->first+"' iterator target is null",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            if(subject->type == CV::DataType::LIST){
+                auto list = CV::CastRef<CV::DataList>(subject);
+                for(std::size_t i = 0; i < list->v.size(); ++i){
+                    values.push_back(list->v[i]);
+                }
+            }else
+            if(subject->type == CV::DataType::STORE){
+                auto store = CV::CastRef<CV::DataStore>(subject);
+                for(auto &it : store->v.owned()){
+                    values.push_back(it.second);
+                }
+            }else{
+                cursor->setError(
+                    CV_ERROR_MSG_ILLEGAL_ITERATOR,
+                    "'"+token->first+"' expects subject to be LIST or STORE",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            auto loopCtx = ctx->buildContext(true);
+            auto result = ctx->buildNil();
+            CV::ContextType iterCtx;
+
+            for(int i = 0; i < static_cast<int>(values.size()); ++i){
+                loopCtx->setNamed(iterName, values[i]);
+
+                __cv_next_iteration_context(iterCtx, loopCtx);
+
+                for(int j = 1; j < static_cast<int>(token->inner.size()); ++j){
+                    result = Interpret(token->inner[j], cursor, cf, iterCtx);
+                    if(cursor->error){
+                        cursor->subject = token;
+                        return ctx->buildNil();
+                    }
+
+                    if(cf->state == CV::ControlFlowState::RETURN){
+                        return result;
+                    }
+
+                    if(cf->state == CV::ControlFlowState::YIELD){
+                        return result;
+                    }
+
+                    if(cf->state == CV::ControlFlowState::SKIP){
+                        cf->state = CV::ControlFlowState::CONTINUE;
+                        break;
+                    }
+                }
+            }
+
+            return result;
+        };
+        // TRY / IGNORE-ERROR PREFIXER
+        case CV::Opcode::TRY: {
+            if(token->inner.size() != 0){
+                cursor->setError(
+                    CV_ERROR_MSG_MISUSED_PREFIX,
+                    "Try Prefix '"+token->first+"' expects no values",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            if(token->first.size() == 1){
+                cursor->setError(
+                    CV_ERROR_MSG_MISUSED_PREFIX,
+                    "Try Prefix '"+token->first+"' expects an appended body",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            // The body was parsed along with the token, only the error isolation happens per run
+            auto &root = token->guarded;
+            if(root.size() == 0){
+                return ctx->buildNil();
+            }
+
+            // Shadow cursor so failures do not touch the outer/global cursor
+            auto shadowCursor = CV::MakeRef<CV::Cursor>();
+
+            auto previousState = cf->state;
+            auto previousPayload = cf->payload;
+
+            CV::Ref<CV::Data> result = ctx->buildNil();
+
+            for(int i = 0; i < static_cast<int>(root.size()); ++i){
+                result = CV::Interpret(root[i], shadowCursor, cf, ctx);
+
+                if(shadowCursor->error){
+                    // Swallow the error and restore control-flow
+                    cf->state = previousState;
+                    cf->payload = previousPayload;
+                    return ctx->buildNil();
+                }
+
+                if(cf->state == CV::ControlFlowState::YIELD ||
+                   cf->state == CV::ControlFlowState::RETURN ||
+                   cf->state == CV::ControlFlowState::SKIP){
+                    return result;
+                }
+            }
+
+            return result ? result : ctx->buildNil();
+        };
+        // TEMPLATE FORMATTER
+        case CV::Opcode::TEMPLATE: {
+            auto templateCtx = ctx->buildContext(true);
+            std::string output = "";
+
+            auto resolveTemplateName = [&](const std::string &name) -> std::string {
+                auto nameRef = templateCtx->getNamed(name);
+                if(nameRef.first && nameRef.second){
+                    auto value = nameRef.second->unwrap();
+                    if(!value){
+                        return "nil";
+                    }
+
+                    if(value->type == CV::DataType::STRING){
+                        return CV::CastRef<CV::DataString>(value)->v;
+                    }
+
+                    return CV::DataToText(value);
+                }
+
+                // unresolved placeholders are left as-is
+                return "{" + name + "}";
+            };
+
+            auto expandTemplateString = [&](const std::string &src) -> std::string {
+                std::string out;
+                std::size_t i = 0;
+
+                while(i < src.size()){
+                    if(src[i] == '{'){
+                        auto end = src.find('}', i + 1);
+                        if(end != std::string::npos){
+                            auto key = src.substr(i + 1, end - i - 1);
+
+                            if(!key.empty()){
+                                out += resolveTemplateName(key);
+                                i = end + 1;
+                                continue;
+                            }
+                        }
+                    }
+
+                    out += src[i];
+                    ++i;
+                }
+
+                return out;
+            };
+
+            for(int i = 0; i < static_cast<int>(token->inner.size()); ++i){
+                auto &child = token->inner[i];
+
+                auto data = Interpret(child, cursor, cf, templateCtx);
+                if(cursor->error){
+                    cursor->subject = token;
+                    return ctx->buildNil();
+                }
+
+                if(cf->state == CV::ControlFlowState::YIELD){
+                    return data;
+                }
+
+                if(cf->state == CV::ControlFlowState::RETURN ||
+                   cf->state == CV::ControlFlowState::SKIP){
+                    return data;
+                }
+
+                if(!data){
+                    continue;
+                }
+
+                // Named values define template-local names
+                if(data->type == CV::DataType::PROXY){
+                    auto proxy = CV::CastRef<CV::DataProxy>(data);
+
+                    if(proxy->ptype == CV::Prefixer::NAMER && proxy->pname != 0){
+                        if(proxy->target){
+                            templateCtx->setNamed(proxy->pname, proxy->target->unwrap());
+                        }
+                    }
+
+                    // proxies themselves do not directly contribute to output
+                    continue;
+                }
+
+                auto out = data->unwrap();
+                if(!out){
+                    continue;
+                }
+
+                // Only strings are appended directly
+                if(out->type == CV::DataType::STRING){
+                    auto raw = CV::CastRef<CV::DataString>(out)->v;
+                    output += expandTemplateString(raw);
+                }
+            }
+
+            return CV::CastRef<CV::Data>(
+                ctx->buildString(output)
+            );
+        };
+        // EXPANDER
+        case CV::Opcode::EXPANDER: {
+            if(token->inner.size() != 0){
+                cursor->setError(
+                    CV_ERROR_MSG_MISUSED_PREFIX,
+                    "Expander Prefix '"+token->first+"' expects no values",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            if(token->first.size() == 1){
+                cursor->setError(
+                    CV_ERROR_MSG_MISUSED_PREFIX,
+                    "Expander Prefix '"+token->first+"' expects an appended body",
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            std::string statement = std::string(token->first.begin() + 1, token->first.end());
+
+            auto root = CV::BuildTree(statement, cursor);
+            if(cursor->error){
+                cursor->subject = token;
+                return ctx->buildNil();
+            }
+
+            if(root.size() != 1){
+                cursor->setError(
+                    CV_ERROR_MSG_MISUSED_PREFIX,
+                    "Expander Prefix '"+token->first+"' apppended body must a singular LIST",
+                    token
+                );
+                return ctx->buildNil();                
+            }
+
+            auto result = CV::Interpret(root[0], cursor, cf, ctx);
+            if(cursor->error){
+                cursor->subject = token;
+                return ctx->buildNil();
+            }
+            if(cf->state != CV::ControlFlowState::CONTINUE){
+                return result;
+            }
+            result = result->unwrap();
+            if(result->type != CV::DataType::LIST){
+                cursor->setError(
+                    CV_ERROR_MSG_MISUSED_PREFIX,
+                    "Expander Prefix '"+token->first+"' apppended body must a singular LIST",
+                    token
+                );
+                return ctx->buildNil();                   
+            }
+
+            auto proxy = CV::MakeRef<CV::DataProxy>();
+            proxy->ptype = CV::Prefixer::EXPANDER;
+            proxy->target = result;
+
+            return CV::CastRef<CV::Data>(proxy);
+        };
+        /*
+            NAMER
+        */
+        case CV::Opcode::NAMER: {
+            auto &name = token->literal;
+
+            // The name was checked along with the token, only a failed verdict needs any more work
+            switch(token->namerCheck){
+                case CV::NamerCheck::UNSCANNABLE: {
+                    // Scanned again so the error is the scanner's own
+                    CountStatements(name, cursor, token->line);
+                    return ctx->buildNil();
+                };
+                case CV::NamerCheck::COMPLEX: {
+                    cursor->setError(
+                        CV_ERROR_MSG_MISUSED_PREFIX,
+                        "Namer Prefix '"+token->first+"' cannot take any complex token",
+                        token
+                    );
+                    return ctx->buildNil();
+                };
+                case CV::NamerCheck::INVALID: {
+                    cursor->setError(
+                        CV_ERROR_MSG_MISUSED_PREFIX,
+                        "'"+token->first+"' prefixer '"+name+"' is an invalid name",
+                        token
+                    );
+                    return ctx->buildNil();
+                };
+                case CV::NamerCheck::RESERVED: {
+                    cursor->setError(
+                        CV_ERROR_MSG_MISUSED_PREFIX,
+                        "'"+token->first+"' prefixer '"+name+"' is a name of native constructor which cannot be overriden",
+                        token
+                    );
+                    return ctx->buildNil();
+                };
+            }
+
+            // Only expects a single value
+            if(token->inner.size() > 1){
+                cursor->setError(
+                    CV_ERROR_MSG_MISUSED_PREFIX,
+                    "Namer Prefix '"+token->first+"' no more than 1 value. Provided "+std::to_string(token->inner.size()),
+                    token
+                );
+                return ctx->buildNil();
+            }
+
+            auto proxy = CV::MakeRef<CV::DataProxy>();
+            proxy->ptype = CV::Prefixer::NAMER;
+            proxy->pname = token->symbol;
+
+
+            // Evaluate referred value if present
+            if(token->inner.size() == 1){
+                auto target = Interpret(token->inner[0], cursor, cf, ctx);
+                if(cursor->error){
+                    cursor->subject = token;
+                    return ctx->buildNil();
+                }
+
+                if(cf->state != CV::ControlFlowState::CONTINUE){
+                    return target;
+                }
+
+                proxy->target = target;
+            }
+
+            // Name into context if the name is not used
+            if(proxy->target){
+                auto exists = ctx->getNamed(proxy->pname);
+                if(!exists.first && !exists.second){
+                    ctx->setNamed(proxy->pname, proxy->target);
+                    ctx->namedNames.insert(proxy->pname);
+                }
+            }
+
+            return CV::CastRef<CV::Data>(proxy);
+        };
+        /*
+            NIL
+        */
+        case CV::Opcode::NIL: {
+            if(token->inner.size() > 0){
+                return bListConstructFromToken(token, ctx, ctx->buildNil());
+            }else{
+                return ctx->buildNil();
+            } 
+        };
+        /*
+            NUMBER
+        */
+        case CV::Opcode::NUMBER: {
+            if(token->inner.size() > 0){
+                return bListConstructFromToken(token, ctx, ctx->buildNumber(token->number));
+            }else{
+                // Always a new value: mutators change numbers in place
+                return ctx->buildNumber(token->number);
+            }
+        };
+        /*
+            STRING
+        */
+        case CV::Opcode::STRING: {
+            if(token->inner.size() > 0){
+                return bListConstructFromToken(token, ctx, ctx->buildString(token->literal));
+            }else{            
+                return ctx->buildString(token->literal);
+            }
+        };
+        case CV::Opcode::NAME:
+        default: {
+            /*
+                IS NAME?        
+            */   
+            auto hctx = ctx;
+            std::string qname = token->first;
+            auto named = __cv_lookup_mutable_name(token, ctx.get());
+            if(named && *named){
+                auto data = *named;
+
+                switch(data->type){
+                    case CV::DataType::FUNCTION: {
+                        auto fn = CV::CastRef<CV::DataFunction>(data);
+
+                        auto fnCtx = ctx->buildContext(true);
+
+                        __cv_call_binding binding(fn);
+
+                        for(int i = 0; i < static_cast<int>(token->inner.size()); ++i){
+                            auto &c = token->inner[i];
+
+                            auto first = Interpret(c, cursor, cf, fnCtx);
+                            if(cursor->error){
+                                cursor->subject = c;
+                                return ctx->buildNil();
+                            }
+
+                            if(cf->state == CV::ControlFlowState::YIELD){
+                                return first;
+                            }
+
+                            if(cf->state == CV::ControlFlowState::RETURN ||
+                            cf->state == CV::ControlFlowState::SKIP){
+                                return first;
+                            }
+
+                            if(!binding.push(first, i, c, fnCtx, cursor)){
+                                return ctx->buildNil();
+                            }
+                        }
+
+                        if(!binding.complete(qname, token, cursor)){
+                            return ctx->buildNil();
+                        }
+
+                        if(fn->isLambda){
+                            auto r = fn->lambda(binding.params, fnCtx, cursor, token);
+                            if(cursor->error){
+                                cursor->subject = token;
+                                return ctx->buildNil();
+                            }
+                            return r;
                         }else{
-                            auto paramCtx = fnCtx->buildContext(true);
-                            if(fn->isVariadic){
-                                auto list = paramCtx->buildList();
-                                paramCtx->data["@"] = list;
-                                for(int i = 0; i < allParams.size(); ++i){
-                                    list->v.push_back(allParams[i].second);
-                                }
-                                auto r = Interpret(fn->body, cursor, cf, paramCtx);
+                            auto paramCtx = binding.buildBodyContext(fnCtx);
+                            auto r = Interpret(fn->body, cursor, cf, paramCtx);
+                            if(cursor->error){
+                                cursor->subject = token;
+                                return ctx->buildNil();
+                            }  
+                            return r;
+                        }
+
+                        return ctx->buildNil();
+                    };
+                    case CV::DataType::STORE: {
+                        auto store = CV::CastRef<CV::DataStore>(data);
+                        // Does this named proxy come with parameters?
+                        if(token->inner.size() > 0){
+                            std::vector<std::string> names;
+                            // Gather names
+                            for(int i = 0; i < token->inner.size(); ++i){                               
+                                auto fetched = Interpret(token->inner[i], cursor, cf, ctx);
                                 if(cursor->error){
                                     cursor->subject = token;
                                     return ctx->buildNil();
-                                }  
-                                return r;                              
+                                }          
+                                if(cf->state == CV::ControlFlowState::YIELD){
+                                    return fetched;
+                                }        
+                                std::string v = "";       
+                                if(fetched->type == CV::DataType::PROXY){
+                                    auto p = CV::CastRef<CV::DataProxy>(fetched);
+                                    v = CV::SymbolName(p->pname);
+                                }else
+                                if(fetched->type == CV::DataType::STRING){
+                                    auto s = CV::CastRef<CV::DataString>(fetched);
+                                    v = s->v; 
+                                }else{
+                                    cursor->setError(CV_ERROR_MSG_INVALID_ACCESOR, "Store access expects named proxy or a string as key", token);
+                                    return ctx->buildNil();
+                                }
+                                names.push_back(v);
+                            }
+                            // Check if they're indeed part of this
+                            for(int i = 0; i < names.size(); ++i){
+                                if(store->v.count(names[i]) == 0){
+                                    cursor->setError(CV_ERROR_MSG_STORE_UNDEFINED_MEMBER, "Store '"+qname+"' has no member named '"+names[i]+"'", token);
+                                    return ctx->buildNil();             
+                                }
+                            }
+                            // One name returns the value itself
+                            if(names.size() == 1){
+                                return store->v[names[0]];
                             }else{
-                                for(int i = 0; i < allParams.size(); ++i){
-                                    auto &a = allParams[i];
-                                    paramCtx->data[a.first] = a.second;
+                            // Several names returns a list of values
+                                auto list = ctx->buildList();
+                                for(int i = 0; i < names.size(); ++i){
+                                    list->v.push_back( store->v[names[i]] );
                                 }
-                                auto r = Interpret(fn->body, cursor, cf, paramCtx);
-                                if(cursor->error){
-                                    cursor->subject = token;
-                                    return ctx->buildNil();
-                                }  
-                                return r;                                
+                                return list;
                             }
+                        }else{
+                        // Otherwise this must be a list
+                            return store;
+                        }
+                    };  
+                    default: {
+                        if(token->inner.size() > 0){
+                            return bListConstructFromToken(token, ctx, data);
+                        }else{  
+                            return data;
                         }
+                    };
+                }
+            }else{
+                cursor->setError(CV_ERROR_MSG_UNDEFINED_IMPERATIVE, "Name '"+token->first+"'", token);
+                return ctx->buildNil();
+            }
+        };
+    }
+}
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//
+//  VM
+// 
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/*
+    The VM runs the same language as Interpret off a flat instruction list. Calls, literals, lists and the
+    core imperatives (let, mut, cc, if, while, for, fn, skip/return/yield) are compiled into instructions.
+    Everything else (stores, imports, foreach, prefixers...) is kept as a FALLBACK instruction that hands
+    the original token over to Interpret, so both engines always agree on results and errors.
+
+    Every construct owns an exit: when a child leaves the control flow in a state the construct must stop on
+    (YIELD, RETURN or SKIP), EXIT_IF unwinds the VM stacks back to the depth the construct started at and
+    jumps past it carrying the child's value, which is what returning early from Interpret does.
+*/
+namespace CV {
+    namespace VMOp {
+        enum VMOp : int {
+            NIL,
+            NUMBER,
+            STRING,
+            FALLBACK,
+            POP,
+            STORE,
+            JUMP,
+            JUMP_IF_FALSE,
+            EXIT_IF,
+            SKIP_TO,
+            STATE,
+            PUSH_CTX,
+            POP_CTX,
+            RENEW_CTX,
+            LET_CHECK,
+            LET_STORE,
+            MUT_LOOKUP,
+            MUT_APPLY,
+            COPY,
+            MAKE_FN,
+            GROUP,
+            APPEND,
+            CALL,
+            ARG,
+            CALL_END,
+            FOR_SETUP,
+            FOR_TEST,
+            FOR_STEP,
+            FOR_END,
+            RETURN
+        };
+    }
+
+    struct Instruction {
+        int op;
+        int a;
+        int b;
+        int c;
+        // Token the cursor's subject is moved to if this instruction fails (-1 leaves it as is)
+        int subject;
+    };
+
+    // Depth of every VM stack at the start of a construct and where it ends
+    struct BytecodeExit {
+        int target;
+        int values;
+        int contexts;
+        int loops;
+        int calls;
+    };
+
+    struct BytecodeFunction {
+        int entry;
+        int body;
+        std::vector<CV::Symbol> params;
+        std::unordered_map<CV::Symbol, int> paramIndex;
+        bool isVariadic;
+    };
+
+    struct Bytecode : CV::Counted {
+        std::vector<CV::Instruction> code;
+        std::vector<CV_NUMBER> numbers;
+        std::vector<std::string> strings;
+        std::vector<CV::Symbol> symbols;
+        std::vector<CV::TokenType> tokens;
+        std::vector<CV::BytecodeExit> exits;
+        std::vector<CV::BytecodeFunction> functions;
+    };
+}
+
+void CV::RefRetain(const CV::Bytecode *p){
+    p->retain();
+}
+
+void CV::RefRelease(const CV::Bytecode *p){
+    p->release();
+}
+
+//
+// SHARING
+//
+/*
+    Marks everything reachable as shared (see CV::Counted), down to the tokens of function bodies and what
+    the VM compiled them into. Anything already shared (or immortal) was marked along with all it reaches
+*/
+static void __cv_share(const CV::Token *token){
+    if(!token || token->shared()){
+        return;
+    }
+    token->share();
+    if(token->arena){
+        token->arena->share();
+    }
+    for(auto &inner : token->inner){
+        __cv_share(inner.get());
+    }
+    for(auto &guarded : token->guarded){
+        __cv_share(guarded.get());
+    }
+}
+
+static void __cv_share(const CV::Bytecode *code){
+    if(!code || code->shared()){
+        return;
+    }
+    code->share();
+    for(auto &token : code->tokens){
+        __cv_share(token.get());
+    }
+}
+
+static void __cv_share(CV::Data *d){
+    if(!d || d->shared()){
+        return;
+    }
+    d->share();
+    // The collector only ever walks what its own thread holds alone
+    if(d->tracked){
+        __cv_gc_forget(d);
+    }
+    switch(d->type){
+        case CV::DataType::LIST: {
+            auto &items = static_cast<CV::DataList*>(d)->v;
+            for(auto &chunk : items.chunks){
+                if(!chunk->shared()){
+                    chunk->share();
+                    for(auto &item : chunk->items){
+                        __cv_share(item.get());
+                    }
+                }
+            }
+            for(auto &item : items.tail){
+                __cv_share(item.get());
+            }
+        } break;
+        case CV::DataType::STORE: {
+            // All of it goes into the shared members, copying the store from another thread then leaves it untouched
+            auto &items = static_cast<CV::DataStore*>(d)->v;
+            if(!items.shared || !items.own.empty()){
+                auto members = CV::MakeRef<CV::StoreMembers>();
+                if(items.shared){
+                    members->items = items.shared->items;
+                }
+                for(auto &it : items.own){
+                    members->items.insert_or_assign(it.first, std::move(it.second));
+                }
+                items.own.clear();
+                items.shared = members;
+                items.added = 0;
+            }
+            items.exposed = false;
+            if(!items.shared->shared()){
+                items.shared->share();
+                for(auto &it : items.shared->items){
+                    __cv_share(it.second.get());
+                }
+            }
+        } break;
+        case CV::DataType::FUNCTION: {
+            auto fn = static_cast<CV::DataFunction*>(d);
+            __cv_share(fn->body.get());
+            __cv_share(fn->code.get());
+        } break;
+        case CV::DataType::PROXY: {
+            __cv_share(static_cast<CV::DataProxy*>(d)->target.get());
+        } break;
+        case CV::DataType::CONTEXT: {
+            auto ctx = static_cast<CV::Context*>(d);
+            __cv_share(ctx->head.get());
+            for(auto &it : ctx->data){
+                __cv_share(it.second.get());
+            }
+        } break;
+        default:
+            break;
+    }
+}
+
+void CV::Share(const CV::Ref<CV::Data> &value){
+    __cv_share(value.get());
+}
+
+static int __cv_vm_states(std::initializer_list<int> states){
+    int mask = 0;
+    for(auto state : states){
+        mask |= 1 << state;
+    }
+    return mask;
+}
+
+// Whether running a token through Interpret may bind names into the context it runs in
+static bool __cv_may_bind(const CV::TokenType &token){
+    switch(token->opcode){
+        case CV::Opcode::LET:
+        case CV::Opcode::IMPORT:
+        case CV::Opcode::IMPORT_DYNAMIC_LIBRARY:
+        case CV::Opcode::TRY: {
+            return true;
+        };
+        case CV::Opcode::NAMER: {
+            if(token->inner.size() > 0){
+                return true;
+            }
+            break;
+        };
+    }
+    for(int i = 0; i < static_cast<int>(token->inner.size()); ++i){
+        if(__cv_may_bind(token->inner[i])){
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+    A context the compiled code is known to run in. 'names' are the ones compiled code binds into it, a scope
+    stops being sealed once anything the compiler can't see into (Interpret, call parameters) may add to it
+*/
+struct __cv_vm_scope {
+    int parent;
+    bool sealed;
+    std::unordered_set<std::string> names;
+};
+
+struct __cv_vm_reference {
+    int at;
+    int scope;
+    std::string name;
+};
+
+struct __cv_vm_compiler {
+    CV::Bytecode *bc;
+    // Depth of the VM stacks at the instruction being emitted
+    int values;
+    int contexts;
+    int loops;
+    int calls;
+    std::unordered_map<CV::Token*, int> tokenIndex;
+    std::unordered_map<std::string, int> stringIndex;
+    std::unordered_map<CV::Symbol, int> symbolIndex;
+    std::vector<int> pending;
+    // Scopes of the unit being compiled and the name lookups waiting for them to be complete
+    std::vector<__cv_vm_scope> scopes;
+    std::vector<__cv_vm_reference> references;
+    int scope;
+
+    __cv_vm_compiler(CV::Bytecode *bc){
+        this->bc = bc;
+        this->values = 0;
+        this->contexts = 0;
+        this->loops = 0;
+        this->calls = 0;
+        this->scope = -1;
+    }
 
-                        return ctx->buildNil();
-                    };
-                    case CV::DataType::STORE: {
-                        auto store = std::static_pointer_cast<CV::DataStore>(data);
-                        // Does this named proxy come with parameters?
-                        if(token->inner.size() > 0){
-                            std::vector<std::string> names;
-                            // Gather names
-                            for(int i = 0; i < token->inner.size(); ++i){                               
-                                auto fetched = Interpret(token->inner[i], cursor, cf, ctx);
-                                if(cursor->error){
-                                    cursor->subject = token;
-                                    return ctx->buildNil();
-                                }          
-                                if(cf->state == CV::ControlFlowState::YIELD){
-                                    return fetched;
-                                }        
-                                std::string v = "";       
-                                if(fetched->type == CV::DataType::PROXY){
-                                    auto p = std::static_pointer_cast<CV::DataProxy>(fetched);
-                                    v = p->pname;
-                                }else
-                                if(fetched->type == CV::DataType::STRING){
-                                    auto s = std::static_pointer_cast<CV::DataString>(fetched);
-                                    v = s->v; 
-                                }else{
-                                    cursor->setError(CV_ERROR_MSG_INVALID_ACCESOR, "Store access expects named proxy or a string as key", token);
-                                    return ctx->buildNil();
-                                }
-                                names.push_back(v);
-                            }
-                            // Check if they're indeed part of this
-                            for(int i = 0; i < names.size(); ++i){
-                                if(store->v.count(names[i]) == 0){
-                                    cursor->setError(CV_ERROR_MSG_STORE_UNDEFINED_MEMBER, "Store '"+qname+"' has no member named '"+names[i]+"'", token);
-                                    return ctx->buildNil();             
-                                }
-                            }
-                            // One name returns the value itself
-                            if(names.size() == 1){
-                                return store->v[names[0]];
-                            }else{
-                            // Several names returns a list of values
-                                auto list = ctx->buildList();
-                                for(int i = 0; i < names.size(); ++i){
-                                    list->v.push_back( store->v[names[i]] );
-                                }
-                                return list;
-                            }
-                        }else{
-                        // Otherwise this must be a list
-                            return store;
-                        }
-                    };  
-                    default: {
-                        if(token->inner.size() > 0){
-                            return bListConstructFromToken(token, ctx);
-                        }else{  
-                            return data;
+    int here() const {
+        return static_cast<int>(bc->code.size());
+    }
+
+    int emit(int op, int a = 0, int b = 0, int subject = -1){
+        bc->code.push_back({op, a, b, -1, subject});
+        return here() - 1;
+    }
+
+    void patch(int at, int target){
+        bc->code[at].a = target;
+    }
+
+    int token(const CV::TokenType &t){
+        auto it = tokenIndex.find(t.get());
+        if(it != tokenIndex.end()){
+            return it->second;
+        }
+        bc->tokens.push_back(t);
+        tokenIndex[t.get()] = bc->tokens.size() - 1;
+        return bc->tokens.size() - 1;
+    }
+
+    int string(const std::string &s){
+        auto it = stringIndex.find(s);
+        if(it != stringIndex.end()){
+            return it->second;
+        }
+        bc->strings.push_back(s);
+        stringIndex[s] = bc->strings.size() - 1;
+        return bc->strings.size() - 1;
+    }
+
+    int symbol(CV::Symbol s){
+        auto it = symbolIndex.find(s);
+        if(it != symbolIndex.end()){
+            return it->second;
+        }
+        bc->symbols.push_back(s);
+        symbolIndex[s] = bc->symbols.size() - 1;
+        return bc->symbols.size() - 1;
+    }
+
+    int openExit(){
+        bc->exits.push_back({-1, values, contexts, loops, calls});
+        return bc->exits.size() - 1;
+    }
+
+    void closeExit(int exit){
+        bc->exits[exit].target = here();
+    }
+
+    void exitOn(std::initializer_list<int> states, int exit){
+        emit(CV::VMOp::EXIT_IF, __cv_vm_states(states), exit);
+    }
+
+    // Mirrors a context pushed by the instruction just emitted
+    void openScope(bool sealed = true){
+        scopes.push_back({scope, sealed, {}});
+        scope = scopes.size() - 1;
+        ++contexts;
+    }
+
+    void closeScope(){
+        scope = scopes[scope].parent;
+        --contexts;
+    }
+
+    // The lookup done by instruction 'at' gets its starting depth ('c') once the unit is compiled
+    void reference(int at, const std::string &name){
+        references.push_back({at, scope, name});
+    }
+
+    // Skips the scopes that can't hold 'name'. Unit roots are never sealed, so a lookup never leaves the unit
+    int resolve(const __cv_vm_reference &ref){
+        int depth = 0;
+        for(int s = ref.scope; s >= 0; s = scopes[s].parent){
+            if(!scopes[s].sealed || scopes[s].names.count(ref.name) > 0){
+                return depth;
+            }
+            ++depth;
+        }
+        return 0;
+    }
+
+    // Compiles a token and all of its children into one self contained unit ending with RETURN
+    int unit(const CV::TokenType &t){
+        int entry = here();
+        values = 0;
+        contexts = 0;
+        loops = 0;
+        calls = 0;
+        // The root is the context the unit is executed in: the caller's or a function's parameters
+        scopes.clear();
+        references.clear();
+        scopes.push_back({-1, false, {}});
+        scope = 0;
+        compile(t, -1);
+        emit(CV::VMOp::RETURN);
+        for(auto &ref : references){
+            bc->code[ref.at].c = resolve(ref);
+        }
+        return entry;
+    }
+
+    // Function bodies are units of their own, compiled once the unit defining them is done
+    void drain(){
+        while(!pending.empty()){
+            int fn = pending.back();
+            pending.pop_back();
+            // Copied: compiling the body grows the pools
+            auto body = bc->tokens[bc->functions[fn].body];
+            int entry = unit(body);
+            bc->functions[fn].entry = entry;
+        }
+    }
+
+    /*
+        'inherit' is the token an ancestor moves the subject to on errors (-1 for none). The outermost one
+        wins, so children inherit it and only fall back to their own token when there is none
+    */
+    void compile(const CV::TokenType &t, int inherit){
+        if(!compileNative(t, inherit)){
+            emit(CV::VMOp::FALLBACK, token(t), 0, inherit);
+            ++values;
+            if(__cv_may_bind(t)){
+                scopes[scope].sealed = false;
+            }
+        }
+    }
+
+    bool compileNative(const CV::TokenType &t, int inherit){
+        if(t->first.size() == 0 && t->inner.size() == 0){
+            return false;
+        }
+
+        int own = inherit >= 0 ? inherit : token(t);
+
+        switch(t->opcode){
+            /*
+                LITERALS
+            */
+            case CV::Opcode::NIL:
+            case CV::Opcode::NUMBER:
+            case CV::Opcode::STRING: {
+                if(t->inner.size() > 0){
+                    return false;
+                }
+                if(t->opcode == CV::Opcode::NIL){
+                    emit(CV::VMOp::NIL);
+                }else
+                if(t->opcode == CV::Opcode::NUMBER){
+                    bc->numbers.push_back(t->number);
+                    emit(CV::VMOp::NUMBER, bc->numbers.size() - 1);
+                }else{
+                    emit(CV::VMOp::STRING, string(t->literal));
+                }
+                ++values;
+                return true;
+            };
+            /*
+                INSTRUCTION LIST
+            */
+            case CV::Opcode::GROUP: {
+                if(__cv_are_all_names(t)){
+                    return false;
+                }
+                int exit = openExit();
+                int self = token(t);
+                emit(CV::VMOp::GROUP, self, exit, inherit);
+                ++values;
+                if(t->inner.size() >= 2 && __cv_may_bind(t)){
+                    scopes[scope].sealed = false;
+                }
+                for(int i = 0; i < static_cast<int>(t->inner.size()); ++i){
+                    compile(t->inner[i], own);
+                    exitOn({CV::ControlFlowState::YIELD, CV::ControlFlowState::RETURN, CV::ControlFlowState::SKIP}, exit);
+                    emit(CV::VMOp::APPEND, token(t->inner[i]), self, inherit);
+                    --values;
+                }
+                closeExit(exit);
+                return true;
+            };
+            /*
+                SKIP / RETURN / YIELD
+            */
+            case CV::Opcode::SKIP:
+            case CV::Opcode::RETURN:
+            case CV::Opcode::YIELD: {
+                if(t->inner.size() > 1){
+                    return false;
+                }
+                int state = CV::ControlFlowState::RETURN;
+                if(t->opcode == CV::Opcode::SKIP){
+                    state = CV::ControlFlowState::SKIP;
+                }else
+                if(t->opcode == CV::Opcode::YIELD){
+                    state = CV::ControlFlowState::YIELD;
+                }
+                emit(CV::VMOp::STATE, state);
+                if(t->inner.size() > 0){
+                    compile(t->inner[0], own);
+                }else{
+                    emit(CV::VMOp::NIL);
+                    ++values;
+                }
+                return true;
+            };
+            /*
+                FN
+            */
+            case CV::Opcode::FN: {
+                if(t->inner.size() != 2){
+                    return false;
+                }
+                CV::BytecodeFunction fn;
+                fn.entry = -1;
+                fn.body = token(t->inner[1]);
+                fn.isVariadic = false;
+
+                auto paramNameList = t->inner[0]->inner;
+                paramNameList.insert(paramNameList.begin(), t->inner[0]);
+
+                if(paramNameList.size() == 1 && paramNameList[0]->first == "@"){
+                    fn.isVariadic = true;
+                }else{
+                    // Anything Interpret would complain about is left for it to report
+                    for(int i = 0; i < paramNameList.size(); ++i){
+                        auto &name = paramNameList[i]->first;
+                        auto symbol = __cv_token_symbol(paramNameList[i]);
+                        if(!CV::Tools::isValidVarName(name) || CV::Tools::isReservedWord(name) ||
+                           fn.paramIndex.count(symbol) > 0 || name == "@"){
+                            return false;
                         }
-                    };
+                        fn.params.push_back(symbol);
+                        fn.paramIndex[symbol] = i;
+                    }
+                }
+
+                bc->functions.push_back(fn);
+                pending.push_back(bc->functions.size() - 1);
+                emit(CV::VMOp::MAKE_FN, bc->functions.size() - 1);
+                ++values;
+                return true;
+            };
+            /*
+                CC
+            */
+            case CV::Opcode::CC: {
+                if(t->inner.size() != 1){
+                    return false;
+                }
+                int exit = openExit();
+                compile(t->inner[0], own);
+                exitOn({CV::ControlFlowState::YIELD}, exit);
+                emit(CV::VMOp::COPY);
+                closeExit(exit);
+                return true;
+            };
+            /*
+                MUT
+            */
+            case CV::Opcode::MUT: {
+                if(t->inner.size() != 2){
+                    return false;
+                }
+                int exit = openExit();
+                int self = token(t);
+                reference(emit(CV::VMOp::MUT_LOOKUP, self, 0, inherit), t->inner[0]->first);
+                ++values;
+                compile(t->inner[1], own);
+                exitOn({CV::ControlFlowState::YIELD}, exit);
+                emit(CV::VMOp::MUT_APPLY, self, 0, inherit);
+                --values;
+                closeExit(exit);
+                return true;
+            };
+            /*
+                LET
+            */
+            case CV::Opcode::LET: {
+                if(t->inner.size() != 2 || t->inner[0]->inner.size() != 0){
+                    return false;
+                }
+                auto &name = t->inner[0]->first;
+                if(!CV::Tools::isValidVarName(name) || CV::Tools::isReservedWord(name)){
+                    return false;
+                }
+                int exit = openExit();
+                int nameIndex = symbol(__cv_token_symbol(t->inner[0]));
+                reference(emit(CV::VMOp::LET_CHECK, nameIndex, token(t), inherit), name);
+                compile(t->inner[1], own);
+                exitOn({CV::ControlFlowState::YIELD}, exit);
+                emit(CV::VMOp::LET_STORE, nameIndex);
+                scopes[scope].names.insert(name);
+                closeExit(exit);
+                return true;
+            };
+            /*
+                IF
+            */
+            case CV::Opcode::IF: {
+                if(t->inner.size() != 2 && t->inner.size() != 3){
+                    return false;
+                }
+                int exit = openExit();
+                compile(t->inner[0], own);
+                exitOn({CV::ControlFlowState::YIELD, CV::ControlFlowState::RETURN, CV::ControlFlowState::SKIP}, exit);
+                int toElse = emit(CV::VMOp::JUMP_IF_FALSE);
+                --values;
+                // Branches don't claim the subject for themselves
+                compile(t->inner[1], inherit);
+                int toEnd = emit(CV::VMOp::JUMP);
+                --values;
+                patch(toElse, here());
+                if(t->inner.size() == 3){
+                    compile(t->inner[2], inherit);
+                }else{
+                    emit(CV::VMOp::NIL);
+                    ++values;
+                }
+                patch(toEnd, here());
+                closeExit(exit);
+                return true;
+            };
+            /*
+                WHILE
+            */
+            case CV::Opcode::WHILE: {
+                if(t->inner.size() < 2){
+                    return false;
+                }
+                int exit = openExit();
+                int result = values;
+                emit(CV::VMOp::NIL);
+                ++values;
+
+                emit(CV::VMOp::PUSH_CTX);
+                openScope();
+                int top = here();
+                compile(t->inner[0], own);
+                exitOn({CV::ControlFlowState::RETURN, CV::ControlFlowState::YIELD}, exit);
+                int conditionSkip = emit(CV::VMOp::SKIP_TO);
+                int toBreak = emit(CV::VMOp::JUMP_IF_FALSE);
+                --values;
+
+                std::vector<int> skips;
+                for(int i = 1; i < static_cast<int>(t->inner.size()); ++i){
+                    compile(t->inner[i], own);
+                    exitOn({CV::ControlFlowState::RETURN, CV::ControlFlowState::YIELD}, exit);
+                    emit(CV::VMOp::STORE, result);
+                    --values;
+                    skips.push_back(emit(CV::VMOp::SKIP_TO));
+                }
+                for(auto at : skips){
+                    patch(at, here());
+                }
+                emit(CV::VMOp::RENEW_CTX);
+                emit(CV::VMOp::JUMP, top);
+
+                // A skipped condition leaves its value behind
+                patch(conditionSkip, here());
+                emit(CV::VMOp::POP);
+                emit(CV::VMOp::RENEW_CTX);
+                emit(CV::VMOp::JUMP, top);
+
+                patch(toBreak, here());
+                emit(CV::VMOp::POP_CTX);
+                closeScope();
+                closeExit(exit);
+                return true;
+            };
+            /*
+                FOR
+            */
+            case CV::Opcode::FOR: {
+                if(t->inner.size() < 2){
+                    return false;
+                }
+                int exit = openExit();
+                int result = values;
+                compile(t->inner[0], own);
+                exitOn({CV::ControlFlowState::YIELD}, exit);
+                // Replaces the clause with the result and enters the loop's context
+                emit(CV::VMOp::FOR_SETUP, token(t), 0, inherit);
+                ++loops;
+                // The iterator's name is only known here if the clause is spelled out as [~name RANGE]
+                auto &clause = t->inner[0];
+                bool named = clause->opcode == CV::Opcode::NAMER && clause->first.size() > 1 && clause->inner.size() == 1;
+                openScope(named);
+                if(named){
+                    scopes[scope].names.insert(clause->literal);
+                }
+
+                emit(CV::VMOp::PUSH_CTX);
+                openScope();
+                int top = emit(CV::VMOp::FOR_TEST);
+
+                std::vector<int> skips;
+                for(int i = 1; i < static_cast<int>(t->inner.size()); ++i){
+                    compile(t->inner[i], own);
+                    exitOn({CV::ControlFlowState::RETURN, CV::ControlFlowState::YIELD}, exit);
+                    emit(CV::VMOp::STORE, result);
+                    --values;
+                    skips.push_back(emit(CV::VMOp::SKIP_TO));
+                }
+                for(auto at : skips){
+                    patch(at, here());
+                }
+                emit(CV::VMOp::RENEW_CTX);
+                emit(CV::VMOp::FOR_STEP);
+                emit(CV::VMOp::JUMP, top);
+
+                patch(top, here());
+                emit(CV::VMOp::POP_CTX);
+                closeScope();
+                emit(CV::VMOp::FOR_END);
+                --loops;
+                closeScope();
+                closeExit(exit);
+                return true;
+            };
+            /*
+                NAME
+            */
+            case CV::Opcode::NAME: {
+                int exit = openExit();
+                int self = token(t);
+                // Only functions reach the arguments, anything else is resolved and jumps to the exit
+                reference(emit(CV::VMOp::CALL, self, exit, inherit), t->first);
+                // Stores and lists led by a name run through Interpret right in this context
+                if(__cv_may_bind(t)){
+                    scopes[scope].sealed = false;
+                }
+                openScope();
+                ++calls;
+                for(int i = 0; i < static_cast<int>(t->inner.size()); ++i){
+                    auto &c = t->inner[i];
+                    compile(c, inherit >= 0 ? inherit : token(c));
+                    exitOn({CV::ControlFlowState::YIELD, CV::ControlFlowState::RETURN, CV::ControlFlowState::SKIP}, exit);
+                    emit(CV::VMOp::ARG, i, token(c), inherit);
+                    --values;
+                }
+                emit(CV::VMOp::CALL_END, self, 0, own);
+                closeScope();
+                --calls;
+                ++values;
+                closeExit(exit);
+                return true;
+            };
+            default: {
+                return false;
+            };
+        }
+    }
+};
+
+struct __cv_vm_loop {
+    __cv_for_range range;
+    CV::Ref<CV::DataNumber> iterValue;
+};
+
+// Stacks shared by every unit running within the same Execute, so calling a function allocates nothing here
+struct __cv_vm_state {
+    std::vector<CV::Value> stack;
+    std::vector<CV::ContextType> contexts;
+    std::vector<__cv_vm_loop> loops;
+    std::vector<__cv_call_binding> calls;
+};
+
+static CV::Ref<CV::Data> __cv_vm_run(
+    __cv_vm_state &state,
+    const CV::BytecodeType &bc,
+    int entry,
+    const CV::CursorType &cursor,
+    const CV::ControlFlowType &cf,
+    const CV::ContextType &ctx
+){
+    auto &stack = state.stack;
+    auto &contexts = state.contexts;
+    auto &loops = state.loops;
+    auto &calls = state.calls;
+
+    // This unit's frame starts where its caller's stacks currently end
+    int valueBase = stack.size();
+    int contextBase = contexts.size();
+    int loopBase = loops.size();
+    int callBase = calls.size();
+    contexts.push_back(ctx);
+
+    auto unwind = [&](){
+        stack.resize(valueBase);
+        contexts.erase(contexts.begin() + contextBase, contexts.end());
+        loops.erase(loops.begin() + loopBase, loops.end());
+        calls.erase(calls.begin() + callBase, calls.end());
+    };
+
+    // Context a resolved lookup starts from, 'c' levels above the current one
+    auto scopeOf = [&](const CV::Instruction &ins) -> const CV::ContextType& {
+        return contexts[contexts.size() - 1 - ins.c];
+    };
+
+    auto fail = [&](const CV::Instruction &ins){
+        if(ins.subject >= 0){
+            cursor->subject = bc->tokens[ins.subject];
+        }
+        unwind();
+        return ctx->buildNil();
+    };
+
+    int pc = entry;
+
+    while(true){
+        const auto &ins = bc->code[pc++];
+
+        switch(ins.op){
+            case CV::VMOp::NIL: {
+                stack.emplace_back();
+                break;
+            };
+            case CV::VMOp::NUMBER: {
+                stack.emplace_back(bc->numbers[ins.a]);
+                break;
+            };
+            case CV::VMOp::STRING: {
+                stack.emplace_back(contexts.back()->buildString(bc->strings[ins.a]));
+                break;
+            };
+            case CV::VMOp::FALLBACK: {
+                auto r = CV::Interpret(bc->tokens[ins.a], cursor, cf, contexts.back());
+                if(cursor->error){
+                    return fail(ins);
+                }
+                stack.push_back(r);
+                break;
+            };
+            case CV::VMOp::POP: {
+                stack.pop_back();
+                break;
+            };
+            case CV::VMOp::STORE: {
+                stack[valueBase + ins.a] = std::move(stack.back());
+                stack.pop_back();
+                break;
+            };
+            case CV::VMOp::JUMP: {
+                pc = ins.a;
+                break;
+            };
+            case CV::VMOp::JUMP_IF_FALSE: {
+                auto &top = stack.back();
+                bool v = top.isImmediate() ? top.type == CV::DataType::NUMBER && top.number != 0 : __cv_get_boolean_value(top.ref);
+                stack.pop_back();
+                if(!v){
+                    pc = ins.a;
+                }
+                break;
+            };
+            case CV::VMOp::EXIT_IF: {
+                if((ins.a & (1 << cf->state)) == 0){
+                    break;
+                }
+                auto &exit = bc->exits[ins.b];
+                auto v = std::move(stack.back());
+                stack.resize(valueBase + exit.values);
+                stack.push_back(std::move(v));
+                contexts.erase(contexts.begin() + contextBase + 1 + exit.contexts, contexts.end());
+                loops.erase(loops.begin() + loopBase + exit.loops, loops.end());
+                calls.erase(calls.begin() + callBase + exit.calls, calls.end());
+                pc = exit.target;
+                break;
+            };
+            case CV::VMOp::SKIP_TO: {
+                if(cf->state == CV::ControlFlowState::SKIP){
+                    cf->state = CV::ControlFlowState::CONTINUE;
+                    pc = ins.a;
+                }
+                break;
+            };
+            case CV::VMOp::STATE: {
+                cf->state = ins.a;
+                break;
+            };
+            case CV::VMOp::PUSH_CTX: {
+                auto child = contexts.back()->buildContext(true);
+                contexts.push_back(child);
+                break;
+            };
+            case CV::VMOp::POP_CTX: {
+                contexts.pop_back();
+                break;
+            };
+            case CV::VMOp::RENEW_CTX: {
+                __cv_next_iteration_context(contexts.back(), contexts[contexts.size() - 2]);
+                break;
+            };
+            case CV::VMOp::LET_CHECK: {
+                auto name = bc->symbols[ins.a];
+                auto &c = contexts.back();
+                auto nameRef = scopeOf(ins)->getNamed(name);
+                if(nameRef.first && nameRef.second && c->namedNames.count(name) == 0){
+                    cursor->setError(CV_ERROR_MSG_MISUSED_CONSTRUCTOR, "Name '"+CV::SymbolName(name)+"' is already defined", bc->tokens[ins.b]);
+                    return fail(ins);
+                }
+                break;
+            };
+            case CV::VMOp::LET_STORE: {
+                auto name = bc->symbols[ins.a];
+                auto &c = contexts.back();
+                // The result of 'let' is the bound object itself
+                stack.back() = CV::Value(c->setNamed(name, stack.back().box()));
+                if(c->namedNames.count(name) == 1){
+                    c->namedNames.erase(name);
+                }
+                break;
+            };
+            case CV::VMOp::MUT_LOOKUP: {
+                auto &token = bc->tokens[ins.a];
+                auto named = __cv_lookup_mutable_name(token->inner[0], scopeOf(ins).get());
+                if(!named || !*named){
+                    cursor->setError(CV_ERROR_MSG_UNDEFINED_IMPERATIVE, "Name '"+token->first+"'", token);
+                    return fail(ins);
+                }
+                stack.emplace_back(__cv_mutable_subject(*named));
+                break;
+            };
+            case CV::VMOp::MUT_APPLY: {
+                auto target = std::move(stack.back());
+                stack.pop_back();
+                auto &subject = stack.back().ref;
+                if(target.isImmediate() && target.type == CV::DataType::NUMBER && subject->type == CV::DataType::NUMBER){
+                    static_cast<CV::DataNumber*>(subject.get())->v = target.number;
+                    break;
+                }
+                if(!__cv_mutate(subject, target.box()->unwrap(), bc->tokens[ins.a], cursor)){
+                    return fail(ins);
+                }
+                break;
+            };
+            case CV::VMOp::COPY: {
+                // Numbers and nil held inline are copies already
+                if(!stack.back().isImmediate()){
+                    stack.back() = CV::Value(contexts.back()->copy(stack.back().ref->unwrap()));
+                }
+                break;
+            };
+            case CV::VMOp::MAKE_FN: {
+                auto &proto = bc->functions[ins.a];
+                auto fn = CV::MakeRef<CV::DataFunction>();
+                fn->isLambda = false;
+                fn->isVariadic = proto.isVariadic;
+                fn->params = proto.params;
+                fn->paramIndex = proto.paramIndex;
+                fn->body = bc->tokens[proto.body];
+                fn->code = bc;
+                fn->entry = proto.entry;
+                stack.emplace_back(std::move(fn));
+                break;
+            };
+            case CV::VMOp::GROUP: {
+                auto &token = bc->tokens[ins.a];
+                auto &c = contexts.back();
+                if(token->inner.size() >= 2 && __cv_are_all_functions(token, c)){
+                    auto r = CV::Interpret(token, cursor, cf, c);
+                    if(cursor->error){
+                        return fail(ins);
+                    }
+                    stack.push_back(r);
+                    pc = bc->exits[ins.b].target;
+                }else{
+                    stack.emplace_back(c->buildList());
+                }
+                break;
+            };
+            case CV::VMOp::APPEND: {
+                auto data = stack.back().box();
+                stack.pop_back();
+                auto list = CV::CastRef<CV::DataList>(stack.back().ref);
+                if(!__cv_list_append(list, data, bc->tokens[ins.a], bc->tokens[ins.b], cursor, contexts.back())){
+                    return fail(ins);
+                }
+                break;
+            };
+            case CV::VMOp::CALL: {
+                auto &token = bc->tokens[ins.a];
+                auto c = contexts.back();
+                auto named = __cv_lookup_mutable_name(token, scopeOf(ins).get());
+                if(!named || !*named){
+                    cursor->setError(CV_ERROR_MSG_UNDEFINED_IMPERATIVE, "Name '"+token->first+"'", token);
+                    return fail(ins);
+                }
+                auto data = *named;
+                if(data->type == CV::DataType::FUNCTION){
+                    calls.emplace_back(CV::CastRef<CV::DataFunction>(data));
+                    contexts.push_back(c->buildContext(true));
+                }else
+                if(data->type == CV::DataType::STORE || token->inner.size() > 0){
+                    // Store accessors and list literals led by a name
+                    auto r = CV::Interpret(token, cursor, cf, c);
+                    if(cursor->error){
+                        return fail(ins);
+                    }
+                    stack.push_back(r);
+                    pc = bc->exits[ins.b].target;
+                }else{
+                    stack.push_back(data);
+                    pc = bc->exits[ins.b].target;
+                }
+                break;
+            };
+            case CV::VMOp::ARG: {
+                auto first = std::move(stack.back());
+                stack.pop_back();
+                auto &binding = calls.back();
+                if(binding.hold(first)){
+                    break;
                 }
-            }else{
-                cursor->setError(CV_ERROR_MSG_UNDEFINED_IMPERATIVE, "Name '"+token->first+"'", token);
-                return ctx->buildNil();
-            }
-        }                            
+                binding.release();
+                if(!binding.push(first.box(), ins.a, bc->tokens[ins.b], contexts.back(), cursor)){
+                    return fail(ins);
+                }
+                break;
+            };
+            case CV::VMOp::CALL_END: {
+                auto &token = bc->tokens[ins.a];
+                auto binding = std::move(calls.back());
+                calls.pop_back();
+                auto fnCtx = std::move(contexts.back());
+                contexts.pop_back();
+
+                CV_NUMBER number;
+                if(binding.runKernel(number)){
+                    stack.emplace_back(number);
+                    break;
+                }
+                binding.release();
+
+                if(!binding.complete(token->first, token, cursor)){
+                    return fail(ins);
+                }
+
+                auto &fn = binding.fn;
+                CV::Ref<CV::Data> r;
+                if(fn->isLambda){
+                    r = fn->lambda(binding.params, fnCtx, cursor, token);
+                }else{
+                    auto paramCtx = binding.buildBodyContext(fnCtx);
+                    r = fn->code ? __cv_vm_run(state, fn->code, fn->entry, cursor, cf, paramCtx)
+                                 : CV::Interpret(fn->body, cursor, cf, paramCtx);
+                }
+                if(cursor->error){
+                    return fail(ins);
+                }
+                stack.push_back(r);
+                break;
+            };
+            case CV::VMOp::FOR_SETUP: {
+                auto clauseRaw = stack.back().box();
+                stack.pop_back();
+
+                __cv_vm_loop loop;
+                if(!__cv_for_range_setup(bc->tokens[ins.a], clauseRaw, cursor, loop.range)){
+                    return fail(ins);
+                }
+
+                auto c = contexts.back();
+                auto loopCtx = c->buildContext(true);
+                loop.iterValue = loopCtx->buildNumber(loop.range.current);
+                loopCtx->setNamed(loop.range.name, loop.iterValue);
+
+                stack.emplace_back();
+                loops.push_back(loop);
+                contexts.push_back(loopCtx);
+                break;
+            };
+            case CV::VMOp::FOR_TEST: {
+                auto &loop = loops.back();
+                if(!loop.range.shouldRun(loop.iterValue->v)){
+                    pc = ins.a;
+                }
+                break;
+            };
+            case CV::VMOp::FOR_STEP: {
+                auto &loop = loops.back();
+                loop.iterValue->v += loop.range.step;
+                break;
+            };
+            case CV::VMOp::FOR_END: {
+                loops.pop_back();
+                contexts.pop_back();
+                break;
+            };
+            case CV::VMOp::RETURN:
+            default: {
+                auto r = stack.back().box();
+                unwind();
+                return r;
+            };
+        }
     }
 }
 
+CV::BytecodeType CV::Compile(const CV::TokenType &token){
+    auto bc = CV::MakeRef<CV::Bytecode>();
+    __cv_vm_compiler compiler(bc.get());
+    compiler.unit(token);
+    compiler.drain();
+    return bc;
+}
+
+CV::Ref<CV::Data> CV::Execute(
+    const CV::BytecodeType &code,
+    const CV::CursorType &cursor,
+    const CV::ControlFlowType &cf,
+    const CV::ContextType &ctx
+){
+    __cv_vm_state state;
+    return __cv_vm_run(state, code, 0, cursor, cf, ctx);
+}
+
+CV::Ref<CV::Data> CV::Execute(
+    const CV::TokenType &token,
+    const CV::CursorType &cursor,
+    const CV::ControlFlowType &cf,
+    const CV::ContextType &ctx
+){
+    return CV::Execute(CV::Compile(token), cursor, cf, ctx);
+}
 
-std::shared_ptr<CV::Data> CV::Context::copy(
-    const std::shared_ptr<CV::Data> &target
+//
+// PROGRAMS
+//
+CV::ProgramType CV::BuildProgram(
+    const std::string &source,
+    const CV::CursorType &cursor,
+    int engine
 ){
+    auto program = CV::MakeRef<CV::Program>();
+    program->engine = engine;
+    program->root = CV::BuildTree(source, cursor);
+    if(cursor->error){
+        return nullptr;
+    }
+    if(engine == CV::Engine::VM){
+        program->code.reserve(program->root.size());
+        for(auto &token : program->root){
+            program->code.push_back(CV::Compile(token));
+        }
+    }
+    // Any thread may run it
+    program->share();
+    for(auto &token : program->root){
+        __cv_share(token.get());
+    }
+    for(auto &code : program->code){
+        __cv_share(code.get());
+    }
+    return program;
+}
+
+CV::Ref<CV::Data> CV::Program::run(
+    const CV::ContextType &ctx,
+    const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &inputs,
+    const CV::CursorType &cursor
+) const {
+    auto runCtx = ctx->fork();
+    for(auto &input : inputs){
+        runCtx->setNamed(input.first, input.second);
+    }
+
+    CV::Ref<CV::Data> result = runCtx->buildNil();
+    for(int i = 0; i < static_cast<int>(this->root.size()); ++i){
+        auto cf = CV::MakeRef<CV::ControlFlow>();
+        cf->state = CV::ControlFlowState::CONTINUE;
+
+        result = this->engine == CV::Engine::VM ?
+            CV::Execute(this->code[i], cursor, cf, runCtx) :
+            CV::Interpret(this->root[i], cursor, cf, runCtx);
+        if(cursor->error){
+            return runCtx->buildNil();
+        }
+
+        if(cf->state == CV::ControlFlowState::RETURN ||
+           cf->state == CV::ControlFlowState::YIELD){
+            break;
+        }
+    }
+
+    return result ? result : runCtx->buildNil();
+}
+
+static CV::Ref<CV::Data> __cv_copy(const CV::Ref<CV::Data> &target){
     if(!target){
-        return this->buildNil();
+        return __cv_nil;
     }
 
     switch(target->type){
         case CV::DataType::NUMBER: {
-            return this->buildNumber(
-                std::static_pointer_cast<CV::DataNumber>(target)->v
-            );
+            auto result = CV::MakeRef<CV::DataNumber>();
+            result->v = CV::CastRef<CV::DataNumber>(target)->v;
+            return result;
         }
 
         case CV::DataType::STRING: {
-            return this->buildString(
-                std::static_pointer_cast<CV::DataString>(target)->v
-            );
+            auto result = CV::MakeRef<CV::DataString>();
+            result->v = CV::CastRef<CV::DataString>(target)->v;
+            return result;
         }
 
         case CV::DataType::LIST: {
-            auto result = this->buildList();
-            auto from = std::static_pointer_cast<CV::DataList>(target);
-            for(int i = 0; i < from->v.size(); ++i){
-                result->v.push_back(
-                    this->copy(from->v[i])
-                );
-            }
+            auto result = CV::MakeRef<CV::DataList>();
+            result->v = CV::CastRef<CV::DataList>(target)->v.copy();
             return result;
         }
 
         case CV::DataType::STORE: {
-            auto result = this->buildStore();
-            auto from = std::static_pointer_cast<CV::DataStore>(target);
-            for(auto &it : from->v){
-                result->v[it.first] = this->copy(it.second);
-            }
+            auto result = CV::MakeRef<CV::DataStore>();
+            result->v = CV::CastRef<CV::DataStore>(target)->v.copy();
             return result;
         }
 
         case CV::DataType::FUNCTION: {
-            auto result = std::make_shared<CV::DataFunction>();
-            auto from = std::static_pointer_cast<CV::DataFunction>(target);
+            auto result = CV::MakeRef<CV::DataFunction>();
+            auto from = CV::CastRef<CV::DataFunction>(target);
             result->params = from->params;
+            result->paramIndex = from->paramIndex;
             result->isLambda = from->isLambda;
             result->isVariadic= from->isVariadic;
             result->body = from->body;
             result->lambda = from->lambda;
+            result->code = from->code;
+            result->entry = from->entry;
+            result->kernel = from->kernel;
             return result;
         }
 
         case CV::DataType::PROXY: {
-            auto result = std::make_shared<CV::DataProxy>();
-            auto from = std::static_pointer_cast<CV::DataProxy>(target);
+            auto result = CV::MakeRef<CV::DataProxy>();
+            auto from = CV::CastRef<CV::DataProxy>(target);
             result->pname = from->pname;
             result->ptype = from->ptype;
             result->target = from->target;
@@ -2563,11 +5705,42 @@ std::shared_ptr<CV::Data> CV::Context::copy(
 
         default:
         case CV::DataType::NIL: {
-            return this->buildNil();
+            return __cv_nil;
         }        
     }
 }
 
+CV::Ref<CV::Data> CV::Context::copy(const CV::Ref<CV::Data> &target){
+    return __cv_copy(target);
+}
+
+CV::NameCacheStats CV::GetNameCacheStats(){
+    return __cv_name_cache_stats;
+}
+
+uint64_t CV::GetDataAllocations(){
+    uint64_t built, destroyed;
+    __cv_data_totals(built, destroyed);
+    return built;
+}
+
+CV::CollectorStats CV::GetCollectorStats(){
+    auto stats = __cv_gc_stats;
+    uint64_t built, destroyed;
+    __cv_data_totals(built, destroyed);
+    stats.live = built - destroyed;
+    return stats;
+}
+
+void CV::SetCollectorThresholds(uint64_t pending, uint64_t growth){
+    __cv_gc_pending_threshold = pending;
+    __cv_gc_growth_threshold = growth;
+}
+
+uint64_t CV::Collect(){
+    return __cv_gc_stats.tracked == 0 ? 0 : __cv_gc_collect();
+}
+
 void CV::SetUseColor(bool v){
     UseColorOnText = v;   
 }
@@ -2579,7 +5752,7 @@ std::string CV::GetPrompt(){
 }
 
 
-std::string CV::DataToText(const std::shared_ptr<CV::Data> &t){
+std::string CV::DataToText(const CV::Ref<CV::Data> &t){
     if(!t){
         return  Tools::setTextColor(Tools::Color::BLUE) +
                 "nil" +
@@ -2604,12 +5777,12 @@ std::string CV::DataToText(const std::shared_ptr<CV::Data> &t){
 
         case CV::DataType::NUMBER: {
             return  c_num +
-                    CV::Tools::removeTrailingZeros(std::static_pointer_cast<CV::DataNumber>(t)->v) +
+                    CV::Tools::removeTrailingZeros(CV::CastRef<CV::DataNumber>(t)->v) +
                     c_reset;
         };
 
         case CV::DataType::STRING: {
-            auto out = std::static_pointer_cast<CV::DataString>(t)->v;
+            auto out = CV::CastRef<CV::DataString>(t)->v;
 
             return  c_str +
                     "'" + out + "'" +
@@ -2617,7 +5790,7 @@ std::string CV::DataToText(const std::shared_ptr<CV::Data> &t){
         };
 
         case CV::DataType::FUNCTION: {
-            auto fn = std::static_pointer_cast<CV::DataFunction>(t);
+            auto fn = CV::CastRef<CV::DataFunction>(t);
 
             std::string start    = c_kw + "[" + c_reset;
             std::string end      = c_kw + "]" + c_reset;
@@ -2626,9 +5799,13 @@ std::string CV::DataToText(const std::shared_ptr<CV::Data> &t){
             std::string body     = fn->body.get() ? fn->body->str() : "";
             std::string variadic = c_prefix + "@" + c_reset;
 
+            std::vector<std::string> names;
+            for(auto param : fn->params){
+                names.push_back(CV::SymbolName(param));
+            }
             std::string params = fn->isVariadic
                 ? variadic
-                : CV::Tools::compileList(fn->params);
+                : CV::Tools::compileList(names);
 
             return  start +
                     name + " " +
@@ -2640,13 +5817,15 @@ std::string CV::DataToText(const std::shared_ptr<CV::Data> &t){
         case CV::DataType::LIST: {
             std::string output = c_bracket + "[" + c_reset;
 
-            auto list = std::static_pointer_cast<CV::DataList>(t);
+            auto list = CV::CastRef<CV::DataList>(t);
+            // Only looked at, shared chunks stay shared
+            const auto &items = list->v;
 
-            int total = static_cast<int>(list->v.size());
+            int total = static_cast<int>(items.size());
             int limit = total > 30 ? 10 : total;
 
             for(int i = 0; i < limit; ++i){
-                auto &q = list->v[i];
+                auto &q = items[i];
                 output += q ? CV::DataToText(q) : (c_nil + "nil" + c_reset);
 
                 if(i < limit - 1){
@@ -2667,7 +5846,7 @@ std::string CV::DataToText(const std::shared_ptr<CV::Data> &t){
         case CV::DataType::STORE: {
             std::string output = c_bracket + "[" + c_reset;
 
-            auto store = std::static_pointer_cast<CV::DataStore>(t);
+            auto store = CV::CastRef<CV::DataStore>(t);
 
             int total = static_cast<int>(store->v.size());
             int limit = total > 30 ? 10 : total;
@@ -2697,9 +5876,9 @@ std::string CV::DataToText(const std::shared_ptr<CV::Data> &t){
         };
 
         case CV::DataType::PROXY: {
-            auto proxy = std::static_pointer_cast<CV::DataProxy>(t);
+            auto proxy = CV::CastRef<CV::DataProxy>(t);
 
-            std::string out = c_prefix + "~" + proxy->pname + c_reset;
+            std::string out = c_prefix + "~" + CV::SymbolName(proxy->pname) + c_reset;
 
             if(proxy->target){
                 out += " " + CV::DataToText(proxy->target);
@@ -2715,11 +5894,11 @@ std::string CV::DataToText(const std::shared_ptr<CV::Data> &t){
 }
 
 
-static std::shared_ptr<CV::Data> __cv_unwrap(const std::shared_ptr<CV::Data> &d){
-    return d ? d->unwrap() : std::shared_ptr<CV::Data>(nullptr);
+static CV::Ref<CV::Data> __cv_unwrap(const CV::Ref<CV::Data> &d){
+    return d ? d->unwrap() : CV::Ref<CV::Data>(nullptr);
 }
 
-static bool __cv_bool_value(const std::shared_ptr<CV::Data> &d){
+static bool __cv_bool_value(const CV::Ref<CV::Data> &d){
     auto v = __cv_unwrap(d);
     if(!v){
         return false;
@@ -2729,13 +5908,13 @@ static bool __cv_bool_value(const std::shared_ptr<CV::Data> &d){
         case CV::DataType::NIL:
             return false;
         case CV::DataType::NUMBER:
-            return std::static_pointer_cast<CV::DataNumber>(v)->v != 0;
+            return CV::CastRef<CV::DataNumber>(v)->v != 0;
         case CV::DataType::STRING:
-            return !std::static_pointer_cast<CV::DataString>(v)->v.empty();
+            return !CV::CastRef<CV::DataString>(v)->v.empty();
         case CV::DataType::LIST:
-            return !std::static_pointer_cast<CV::DataList>(v)->v.empty();
+            return !CV::CastRef<CV::DataList>(v)->v.empty();
         case CV::DataType::STORE:
-            return !std::static_pointer_cast<CV::DataStore>(v)->v.empty();
+            return !CV::CastRef<CV::DataStore>(v)->v.empty();
         default:
             return true;
     }
@@ -2743,7 +5922,7 @@ static bool __cv_bool_value(const std::shared_ptr<CV::Data> &d){
 
 static bool __cv_expect_type(
     const std::string &fname,
-    const std::shared_ptr<CV::Data> &value,
+    const CV::Ref<CV::Data> &value,
     CV::DataType expected,
     const CV::CursorType &cursor,
     const CV::TokenType &token
@@ -2763,7 +5942,7 @@ static bool __cv_expect_type(
 
 static bool __cv_expect_at_least(
     const std::string &fname,
-    const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
+    const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
     int n,
     const CV::CursorType &cursor,
     const CV::TokenType &token
@@ -2781,7 +5960,7 @@ static bool __cv_expect_at_least(
 
 static bool __cv_expect_exactly(
     const std::string &fname,
-    const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
+    const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
     int n,
     const CV::CursorType &cursor,
     const CV::TokenType &token
@@ -2797,20 +5976,126 @@ static bool __cv_expect_exactly(
     return true;
 }
 
+/*
+    Kernels: plain number versions of the arithmetic and conditional builtins (see DataFunction::kernel).
+    Whatever their lambdas would report as an error makes them return false instead
+*/
+static bool __cv_kernel_add(const CV_NUMBER *args, int n, CV_NUMBER &out){
+    out = 0;
+    for(int i = 0; i < n; ++i){
+        out += args[i];
+    }
+    return true;
+}
+
+static bool __cv_kernel_sub(const CV_NUMBER *args, int n, CV_NUMBER &out){
+    if(n < 1){
+        return false;
+    }
+    out = args[0];
+    for(int i = 1; i < n; ++i){
+        out -= args[i];
+    }
+    return true;
+}
+
+static bool __cv_kernel_mul(const CV_NUMBER *args, int n, CV_NUMBER &out){
+    out = 1;
+    for(int i = 0; i < n; ++i){
+        out *= args[i];
+    }
+    return true;
+}
+
+static bool __cv_kernel_div(const CV_NUMBER *args, int n, CV_NUMBER &out){
+    if(n < 1){
+        return false;
+    }
+    out = args[0];
+    for(int i = 1; i < n; ++i){
+        if(args[i] == 0){
+            return false;
+        }
+        out /= args[i];
+    }
+    return true;
+}
+
+static bool __cv_kernel_eq(const CV_NUMBER *args, int n, CV_NUMBER &out){
+    if(n != 2){
+        return false;
+    }
+    out = args[0] == args[1] ? 1 : 0;
+    return true;
+}
+
+static bool __cv_kernel_neq(const CV_NUMBER *args, int n, CV_NUMBER &out){
+    if(n != 2){
+        return false;
+    }
+    out = args[0] != args[1] ? 1 : 0;
+    return true;
+}
+
+static bool __cv_kernel_gt(const CV_NUMBER *args, int n, CV_NUMBER &out){
+    if(n != 2){
+        return false;
+    }
+    out = args[0] > args[1] ? 1 : 0;
+    return true;
+}
+
+static bool __cv_kernel_gte(const CV_NUMBER *args, int n, CV_NUMBER &out){
+    if(n != 2){
+        return false;
+    }
+    out = args[0] >= args[1] ? 1 : 0;
+    return true;
+}
+
+static bool __cv_kernel_lt(const CV_NUMBER *args, int n, CV_NUMBER &out){
+    if(n != 2){
+        return false;
+    }
+    out = args[0] < args[1] ? 1 : 0;
+    return true;
+}
+
+static bool __cv_kernel_lte(const CV_NUMBER *args, int n, CV_NUMBER &out){
+    if(n != 2){
+        return false;
+    }
+    out = args[0] <= args[1] ? 1 : 0;
+    return true;
+}
+
+// Attaches a kernel to the builtin just registered as 'fname'
+static void __cv_set_kernel(
+    const CV::Ref<CV::Context> &ctx,
+    const std::string &fname,
+    bool (*kernel)(const CV_NUMBER *args, int n, CV_NUMBER &out)
+){
+    auto it = ctx->data.find(CV::Intern(fname));
+    if(it != ctx->data.end() && it->second->type == CV::DataType::FUNCTION){
+        CV::CastRef<CV::DataFunction>(it->second)->kernel = kernel;
+    }
+}
+
 static void __cv_register_numeric_conditional(
-    const std::shared_ptr<CV::Context> &ctx,
+    const CV::Ref<CV::Context> &ctx,
     const std::string &fname,
-    const std::function<bool(CV_NUMBER, CV_NUMBER)> &comparator
+    const std::function<bool(CV_NUMBER, CV_NUMBER)> &comparator,
+    bool (*kernel)(const CV_NUMBER *args, int n, CV_NUMBER &out)
 ){
     ctx->registerFunction(
         fname,
         {"a", "b"},
         [fname, comparator](
-            const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-            const std::shared_ptr<CV::Context> &fctx,
+            const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+            const CV::Ref<CV::Context> &fctx,
             const CV::CursorType &cursor,
             const CV::TokenType &token
-        ) -> std::shared_ptr<CV::Data> {
+        ) -> CV::Ref<CV::Data> {
 
             if(!__cv_expect_exactly(fname, args, 2, cursor, token)){
                 return fctx->buildNil();
@@ -2824,31 +6109,27 @@ static void __cv_register_numeric_conditional(
                 return fctx->buildNil();
             }
 
-            auto av = std::static_pointer_cast<CV::DataNumber>(a)->v;
-            auto bv = std::static_pointer_cast<CV::DataNumber>(b)->v;
+            auto av = CV::CastRef<CV::DataNumber>(a)->v;
+            auto bv = CV::CastRef<CV::DataNumber>(b)->v;
 
-            return std::static_pointer_cast<CV::Data>(
-                fctx->buildNumber(comparator(av, bv) ? 1 : 0)
-            );
+            return __cv_bool_number(comparator(av, bv));
         }
     );
+    __cv_set_kernel(ctx, fname, kernel);
 }
 
-bool CV::CoreSetup(
-    const std::shared_ptr<CV::Context> &ctx
+static void __cv_register_builtins(
+    const CV::Ref<CV::Context> &ctx
 ){
-    char *cvLibPath = std::getenv("CANVAS_LIB_HOME");
-    CV_LIB_HOME = cvLibPath != nullptr ? std::string(cvLibPath) : "./lib";
-
     ////////////////////////////
     //// ARITHMETIC
     ////////////////////////////
 
     ctx->registerFunction("+",
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
 
             auto result = fctx->buildNumber(0);
 
@@ -2857,18 +6138,19 @@ bool CV::CoreSetup(
                 if(!__cv_expect_type("+", v, CV::DataType::NUMBER, cursor, token)){
                     return fctx->buildNil();
                 }
-                result->v += std::static_pointer_cast<CV::DataNumber>(v)->v;
+                result->v += CV::CastRef<CV::DataNumber>(v)->v;
             }
 
-            return std::static_pointer_cast<CV::Data>(result);
+            return CV::CastRef<CV::Data>(result);
         }
     );
+    __cv_set_kernel(ctx, "+", __cv_kernel_add);
 
     ctx->registerFunction("-",
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
 
             if(!__cv_expect_at_least("-", args, 1, cursor, token)){
                 return fctx->buildNil();
@@ -2879,25 +6161,26 @@ bool CV::CoreSetup(
                 return fctx->buildNil();
             }
 
-            auto result = fctx->buildNumber(std::static_pointer_cast<CV::DataNumber>(first)->v);
+            auto result = fctx->buildNumber(CV::CastRef<CV::DataNumber>(first)->v);
 
             for(int i = 1; i < static_cast<int>(args.size()); ++i){
                 auto v = __cv_unwrap(args[i].second);
                 if(!__cv_expect_type("-", v, CV::DataType::NUMBER, cursor, token)){
                     return fctx->buildNil();
                 }
-                result->v -= std::static_pointer_cast<CV::DataNumber>(v)->v;
+                result->v -= CV::CastRef<CV::DataNumber>(v)->v;
             }
 
-            return std::static_pointer_cast<CV::Data>(result);
+            return CV::CastRef<CV::Data>(result);
         }
     );
+    __cv_set_kernel(ctx, "-", __cv_kernel_sub);
 
     ctx->registerFunction("*",
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
 
             auto result = fctx->buildNumber(1);
 
@@ -2906,18 +6189,19 @@ bool CV::CoreSetup(
                 if(!__cv_expect_type("*", v, CV::DataType::NUMBER, cursor, token)){
                     return fctx->buildNil();
                 }
-                result->v *= std::static_pointer_cast<CV::DataNumber>(v)->v;
+                result->v *= CV::CastRef<CV::DataNumber>(v)->v;
             }
 
-            return std::static_pointer_cast<CV::Data>(result);
+            return CV::CastRef<CV::Data>(result);
         }
     );
+    __cv_set_kernel(ctx, "*", __cv_kernel_mul);
 
     ctx->registerFunction("/",
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
 
             if(!__cv_expect_at_least("/", args, 1, cursor, token)){
                 return fctx->buildNil();
@@ -2928,7 +6212,7 @@ bool CV::CoreSetup(
                 return fctx->buildNil();
             }
 
-            auto result = fctx->buildNumber(std::static_pointer_cast<CV::DataNumber>(first)->v);
+            auto result = fctx->buildNumber(CV::CastRef<CV::DataNumber>(first)->v);
 
             for(int i = 1; i < static_cast<int>(args.size()); ++i){
                 auto v = __cv_unwrap(args[i].second);
@@ -2936,7 +6220,7 @@ bool CV::CoreSetup(
                     return fctx->buildNil();
                 }
 
-                auto tv = std::static_pointer_cast<CV::DataNumber>(v)->v;
+                auto tv = CV::CastRef<CV::DataNumber>(v)->v;
                 if(tv == 0){
                     cursor->setError(
                         CV_ERROR_MSG_MISUSED_FUNCTION,
@@ -2949,48 +6233,45 @@ bool CV::CoreSetup(
                 result->v /= tv;
             }
 
-            return std::static_pointer_cast<CV::Data>(result);
+            return CV::CastRef<CV::Data>(result);
         }
     );
+    __cv_set_kernel(ctx, "/", __cv_kernel_div);
 
     ////////////////////////////
     //// BOOLEAN
     ////////////////////////////
 
     ctx->registerFunction("and",
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
+            (void)fctx;
             (void)cursor;
             (void)token;
 
-            auto result = fctx->buildNumber(1);
-
             for(int i = 0; i < static_cast<int>(args.size()); ++i){
                 if(!__cv_bool_value(args[i].second)){
-                    result->v = 0;
-                    break;
+                    return __cv_bool_number(false);
                 }
             }
 
-            return std::static_pointer_cast<CV::Data>(result);
+            return __cv_bool_number(true);
         }
     );
 
     ctx->registerFunction("not", {"value"},
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
 
             if(!__cv_expect_exactly("not", args, 1, cursor, token)){
                 return fctx->buildNil();
             }
 
-            return std::static_pointer_cast<CV::Data>(
-                fctx->buildNumber(__cv_bool_value(args[0].second) ? 0 : 1)
-            );
+            return __cv_bool_number(!__cv_bool_value(args[0].second));
         }
     );
 
@@ -2998,22 +6279,22 @@ bool CV::CoreSetup(
     //// CONDITIONALS (eager-safe only)
     ////////////////////////////
 
-    __cv_register_numeric_conditional(ctx, "eq",  [](CV_NUMBER a, CV_NUMBER b){ return a == b; });
-    __cv_register_numeric_conditional(ctx, "neq", [](CV_NUMBER a, CV_NUMBER b){ return a != b; });
-    __cv_register_numeric_conditional(ctx, ">",   [](CV_NUMBER a, CV_NUMBER b){ return a >  b; });
-    __cv_register_numeric_conditional(ctx, ">=",  [](CV_NUMBER a, CV_NUMBER b){ return a >= b; });
-    __cv_register_numeric_conditional(ctx, "<",   [](CV_NUMBER a, CV_NUMBER b){ return a <  b; });
-    __cv_register_numeric_conditional(ctx, "<=",  [](CV_NUMBER a, CV_NUMBER b){ return a <= b; });
+    __cv_register_numeric_conditional(ctx, "eq",  [](CV_NUMBER a, CV_NUMBER b){ return a == b; }, __cv_kernel_eq);
+    __cv_register_numeric_conditional(ctx, "neq", [](CV_NUMBER a, CV_NUMBER b){ return a != b; }, __cv_kernel_neq);
+    __cv_register_numeric_conditional(ctx, ">",   [](CV_NUMBER a, CV_NUMBER b){ return a >  b; }, __cv_kernel_gt);
+    __cv_register_numeric_conditional(ctx, ">=",  [](CV_NUMBER a, CV_NUMBER b){ return a >= b; }, __cv_kernel_gte);
+    __cv_register_numeric_conditional(ctx, "<",   [](CV_NUMBER a, CV_NUMBER b){ return a <  b; }, __cv_kernel_lt);
+    __cv_register_numeric_conditional(ctx, "<=",  [](CV_NUMBER a, CV_NUMBER b){ return a <= b; }, __cv_kernel_lte);
 
     ////////////////////////////
     //// LISTS / STORES
     ////////////////////////////
 
     ctx->registerFunction("nth", {"list", "index"},
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
 
             if(!__cv_expect_exactly("nth", args, 2, cursor, token)){
                 return fctx->buildNil();
@@ -3027,8 +6308,8 @@ bool CV::CoreSetup(
                 return fctx->buildNil();
             }
 
-            auto list = std::static_pointer_cast<CV::DataList>(listData);
-            int index = static_cast<int>(std::static_pointer_cast<CV::DataNumber>(indexData)->v);
+            auto list = CV::CastRef<CV::DataList>(listData);
+            int index = static_cast<int>(CV::CastRef<CV::DataNumber>(indexData)->v);
 
             if(index < 0 || index >= static_cast<int>(list->v.size())){
                 cursor->setError(
@@ -3046,10 +6327,10 @@ bool CV::CoreSetup(
     );
 
     ctx->registerFunction("length", {"subject"},
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
 
             if(!__cv_expect_exactly("length", args, 1, cursor, token)){
                 return fctx->buildNil();
@@ -3059,13 +6340,13 @@ bool CV::CoreSetup(
             auto result = fctx->buildNumber(0);
 
             if(data->type == CV::DataType::LIST){
-                result->v = static_cast<CV_NUMBER>(std::static_pointer_cast<CV::DataList>(data)->v.size());
-                return std::static_pointer_cast<CV::Data>(result);
+                result->v = static_cast<CV_NUMBER>(CV::CastRef<CV::DataList>(data)->v.size());
+                return CV::CastRef<CV::Data>(result);
             }
 
             if(data->type == CV::DataType::STORE){
-                result->v = static_cast<CV_NUMBER>(std::static_pointer_cast<CV::DataStore>(data)->v.size());
-                return std::static_pointer_cast<CV::Data>(result);
+                result->v = static_cast<CV_NUMBER>(CV::CastRef<CV::DataStore>(data)->v.size());
+                return CV::CastRef<CV::Data>(result);
             }
 
             cursor->setError(
@@ -3078,10 +6359,10 @@ bool CV::CoreSetup(
     );
 
     ctx->registerFunction(">>", {"subject", "target"},
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
 
             if(!__cv_expect_exactly(">>", args, 2, cursor, token)){
                 return fctx->buildNil();
@@ -3094,20 +6375,23 @@ bool CV::CoreSetup(
                 auto nl = fctx->buildList();
                 nl->v.push_back(target);
                 nl->v.push_back(subject);
-                return std::static_pointer_cast<CV::Data>(nl);
+                return CV::CastRef<CV::Data>(nl);
             }
 
-            auto list = std::static_pointer_cast<CV::DataList>(target);
+            auto list = CV::CastRef<CV::DataList>(target);
             list->v.push_back(subject);
-            return std::static_pointer_cast<CV::Data>(list);
+            if(__cv_gc_container(subject.get())){
+                __cv_gc_watch(target);
+            }
+            return CV::CastRef<CV::Data>(list);
         }
     );
 
     ctx->registerFunction("<<", {"subject"},
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
 
             if(!__cv_expect_exactly("<<", args, 1, cursor, token)){
                 return fctx->buildNil();
@@ -3118,7 +6402,7 @@ bool CV::CoreSetup(
                 return fctx->buildNil();
             }
 
-            auto list = std::static_pointer_cast<CV::DataList>(data);
+            auto list = CV::CastRef<CV::DataList>(data);
             if(list->v.empty()){
                 return fctx->buildNil();
             }
@@ -3130,10 +6414,10 @@ bool CV::CoreSetup(
     );
 
     ctx->registerFunction("l-sub",
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
 
             if(static_cast<int>(args.size()) != 2 && static_cast<int>(args.size()) != 3){
                 cursor->setError(
@@ -3152,8 +6436,8 @@ bool CV::CoreSetup(
                 return fctx->buildNil();
             }
 
-            auto list = std::static_pointer_cast<CV::DataList>(listData);
-            int from = static_cast<int>(std::static_pointer_cast<CV::DataNumber>(fromData)->v);
+            auto list = CV::CastRef<CV::DataList>(listData);
+            int from = static_cast<int>(CV::CastRef<CV::DataNumber>(fromData)->v);
 
             int to = static_cast<int>(list->v.size()) - 1;
             if(static_cast<int>(args.size()) == 3){
@@ -3161,7 +6445,7 @@ bool CV::CoreSetup(
                 if(!__cv_expect_type("l-sub", toData, CV::DataType::NUMBER, cursor, token)){
                     return fctx->buildNil();
                 }
-                to = static_cast<int>(std::static_pointer_cast<CV::DataNumber>(toData)->v);
+                to = static_cast<int>(CV::CastRef<CV::DataNumber>(toData)->v);
             }
 
             if(from < 0 || from >= static_cast<int>(list->v.size()) ||
@@ -3180,15 +6464,15 @@ bool CV::CoreSetup(
                 result->v.push_back(list->v[i]);
             }
 
-            return std::static_pointer_cast<CV::Data>(result);
+            return CV::CastRef<CV::Data>(result);
         }
     );
 
     ctx->registerFunction("l-splice",
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
             (void)cursor;
             (void)token;
 
@@ -3196,15 +6480,15 @@ bool CV::CoreSetup(
             for(int i = 0; i < static_cast<int>(args.size()); ++i){
                 result->v.push_back(__cv_unwrap(args[i].second));
             }
-            return std::static_pointer_cast<CV::Data>(result);
+            return CV::CastRef<CV::Data>(result);
         }
     );
 
     ctx->registerFunction("s-splice",
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
 
             auto result = fctx->buildStore();
 
@@ -3218,10 +6502,10 @@ bool CV::CoreSetup(
                     );
                     return fctx->buildNil();
                 }
-                result->v[vname] = __cv_unwrap(args[i].second);
+                result->v.set(vname, __cv_unwrap(args[i].second));
             }
 
-            return std::static_pointer_cast<CV::Data>(result);
+            return CV::CastRef<CV::Data>(result);
         }
     );
 
@@ -3230,10 +6514,10 @@ bool CV::CoreSetup(
     ////////////////////////////
 
     ctx->registerFunction("++", {"subject"},
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
 
             if(!__cv_expect_exactly("++", args, 1, cursor, token)){
                 return fctx->buildNil();
@@ -3243,17 +6527,18 @@ bool CV::CoreSetup(
             if(!__cv_expect_type("++", subject, CV::DataType::NUMBER, cursor, token)){
                 return fctx->buildNil();
             }
+            subject = __cv_unshared(subject);
 
-            ++std::static_pointer_cast<CV::DataNumber>(subject)->v;
+            ++CV::CastRef<CV::DataNumber>(subject)->v;
             return subject;
         }
     );
 
     ctx->registerFunction("--", {"subject"},
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
 
             if(!__cv_expect_exactly("--", args, 1, cursor, token)){
                 return fctx->buildNil();
@@ -3263,17 +6548,18 @@ bool CV::CoreSetup(
             if(!__cv_expect_type("--", subject, CV::DataType::NUMBER, cursor, token)){
                 return fctx->buildNil();
             }
+            subject = __cv_unshared(subject);
 
-            --std::static_pointer_cast<CV::DataNumber>(subject)->v;
+            --CV::CastRef<CV::DataNumber>(subject)->v;
             return subject;
         }
     );
 
     ctx->registerFunction("//", {"subject"},
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
 
             if(!__cv_expect_exactly("//", args, 1, cursor, token)){
                 return fctx->buildNil();
@@ -3283,17 +6569,18 @@ bool CV::CoreSetup(
             if(!__cv_expect_type("//", subject, CV::DataType::NUMBER, cursor, token)){
                 return fctx->buildNil();
             }
+            subject = __cv_unshared(subject);
 
-            std::static_pointer_cast<CV::DataNumber>(subject)->v /= static_cast<CV_NUMBER>(2.0);
+            CV::CastRef<CV::DataNumber>(subject)->v /= static_cast<CV_NUMBER>(2.0);
             return subject;
         }
     );
 
     ctx->registerFunction("**", {"subject"},
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
 
             if(!__cv_expect_exactly("**", args, 1, cursor, token)){
                 return fctx->buildNil();
@@ -3303,8 +6590,9 @@ bool CV::CoreSetup(
             if(!__cv_expect_type("**", subject, CV::DataType::NUMBER, cursor, token)){
                 return fctx->buildNil();
             }
+            subject = __cv_unshared(subject);
 
-            auto n = std::static_pointer_cast<CV::DataNumber>(subject);
+            auto n = CV::CastRef<CV::DataNumber>(subject);
             n->v = n->v * n->v;
             return subject;
         }
@@ -3315,10 +6603,10 @@ bool CV::CoreSetup(
     ////////////////////////////
 
     ctx->registerFunction("print",
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
 
             std::string out;
 
@@ -3334,7 +6622,7 @@ bool CV::CoreSetup(
                 }
 
                 if(arg->type == CV::DataType::STRING){
-                    out += std::static_pointer_cast<CV::DataString>(arg)->v;
+                    out += CV::CastRef<CV::DataString>(arg)->v;
                 }else{
                     out += CV::DataToText(arg);
                 }
@@ -3346,31 +6634,148 @@ bool CV::CoreSetup(
     );
 
     ctx->registerFunction("typeof", {"subject"},
-        [](const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-           const std::shared_ptr<CV::Context> &fctx,
+        [](const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+           const CV::Ref<CV::Context> &fctx,
            const CV::CursorType &cursor,
-           const CV::TokenType &token) -> std::shared_ptr<CV::Data> {
+           const CV::TokenType &token) -> CV::Ref<CV::Data> {
 
             if(!__cv_expect_exactly("typeof", args, 1, cursor, token)){
                 return fctx->buildNil();
             }
 
             auto subject = __cv_unwrap(args[0].second);
-            return std::static_pointer_cast<CV::Data>(
+            return CV::CastRef<CV::Data>(
                 fctx->buildString(CV::DataTypeName(subject ? subject->type : CV::DataType::NIL))
             );
         }
     );
 
+}
+
+/*
+    Builtins live in one context made the first time anyone asks for it, thread safe as any function local static.
+    Contexts that chain to it (CoreSetup) share it instead of registering every builtin again, from any thread:
+    nothing binds into it afterwards, it and every builtin in it are immortal so holding them never touches a
+    count, and looking names up through it only reads it (frozen, caches don't mark it). The counters lookups
+    depend on (context serial, names version) are atomic, everything else they keep is per thread
+*/
+CV::Ref<CV::Context> CV::GetBuiltins(){
+    static const CV::Ref<CV::Context> builtins = [](){
+        char *cvLibPath = std::getenv("CANVAS_LIB_HOME");
+        CV_LIB_HOME = cvLibPath != nullptr ? std::string(cvLibPath) : "./lib";
+
+        auto ctx = CV::MakeRef<CV::Context>();
+        __cv_register_builtins(ctx);
+        // Shared by every thread from here on: never counted, caches never mark it and 'mut' never touches it
+        ctx->frozen.store(true, std::memory_order_relaxed);
+        ctx->immortalize();
+        for(auto &it : ctx->data){
+            it.second->immortalize();
+        }
+        return ctx;
+    }();
+    return builtins;
+}
+
+bool CV::CoreSetup(
+    const CV::Ref<CV::Context> &ctx
+){
+    auto builtins = CV::GetBuiltins();
+    auto root = ctx.get();
+    while(root->head && root != builtins.get()){
+        root = root->head.get();
+    }
+    if(root != builtins.get()){
+        root->head = builtins;
+    }
     return true;
 }
 
-std::shared_ptr<CV::Data> CV::Import(
+//
+// MODULES
+//
+/*
+    Every '.cv' imported during the runtime is kept by its real path along with the tree it parsed into, shared
+    by every thread. A module whose file changed (modification time or size) is loaded again from scratch.
+    Importing a known module never parses it again but does run it again, unless modules are reused
+    (SetModuleReuse), in which case a context that already ran it just gets back the earlier result. Any thread
+    may import, the registry is only ever touched with its mutex held and never while a module runs
+*/
+struct __cv_module {
+    __cv_file_stamp stamp;
+    std::vector<CV::TokenType> root;
+};
+
+/*
+    What each context got back from the modules it ran, by context id and module. Results belong to the thread
+    that ran them like anything else it builds, so they're kept per thread. A context that imported something
+    takes its results away when it goes
+*/
+struct __cv_module_result {
+    __cv_file_stamp stamp;
+    CV::Ref<CV::Data> value;
+};
+
+// Trivially destructible, tells contexts going away after the thread's results that there's nothing to take
+static thread_local bool __cv_module_results_gone = false;
+
+struct __cv_module_results_state {
+    std::unordered_map<uint64_t, std::unordered_map<std::string, __cv_module_result>> contexts;
+    ~__cv_module_results_state(){
+        __cv_module_results_gone = true;
+    }
+};
+static thread_local __cv_module_results_state __cv_module_results;
+
+static void __cv_forget_module_results(uint64_t context){
+    if(!__cv_module_results_gone){
+        __cv_module_results.contexts.erase(context);
+    }
+}
+
+static std::mutex __cv_modules_mutex;
+static std::unordered_map<std::string, __cv_module> __cv_modules;
+static std::atomic<bool> __cv_reuse_modules(false);
+
+void CV::SetModuleReuse(bool v){
+    __cv_reuse_modules = v;
+}
+
+// Different spellings of the same file ('./a.cv', 'a.cv', 'lib/../a.cv') share one module
+static std::string __cv_module_key(const std::string &path){
+#if (_CV_PLATFORM == _CV_PLATFORM_TYPE_LINUX) || (_CV_PLATFORM == _CV_PLATFORM_TYPE_OSX)
+    char *real = realpath(path.c_str(), NULL);
+    if(real){
+        std::string key(real);
+        free(real);
+        return key;
+    }
+#endif
+    return path;
+}
+
+static CV::Ref<CV::Data> *__cv_module_previous(const CV::ContextType &ctx, const std::string &key, const __cv_file_stamp &stamp){
+    if(!ctx->imported || __cv_module_results_gone){
+        return nullptr;
+    }
+    auto results = __cv_module_results.contexts.find(ctx->id);
+    if(results == __cv_module_results.contexts.end()){
+        return nullptr;
+    }
+    auto result = results->second.find(key);
+    if(result == results->second.end() || !(result->second.stamp == stamp)){
+        return nullptr;
+    }
+    return &result->second.value;
+}
+
+CV::Ref<CV::Data> CV::Import(
     const std::string &fname,
     const CV::ContextType &ctx,
     const CV::CursorType &cursor
 ){
-    if(!CV::Tools::fileExists(fname)){
+    __cv_file_stamp stamp;
+    if(!__cv_stamp_file(fname, stamp)){
         cursor->setError(
             CV_ERROR_MSG_LIBRARY_NOT_VALID,
             "'"+fname+"' does not exist",
@@ -3379,17 +6784,50 @@ std::shared_ptr<CV::Data> CV::Import(
         return ctx->buildNil();
     }
 
-    auto literal = CV::Tools::readFile(fname);
+    auto key = __cv_module_key(fname);
+    if(__cv_reuse_modules){
+        auto previous = __cv_module_previous(ctx, key, stamp);
+        if(previous){
+            return *previous;
+        }
+    }
 
-    auto root = CV::BuildTree(literal, cursor);
-    if(cursor->error){
-        return ctx->buildNil();
+    std::vector<CV::TokenType> root;
+    bool parsed = false;
+    {
+        std::lock_guard<std::mutex> lock(__cv_modules_mutex);
+        auto known = __cv_modules.find(key);
+        if(known != __cv_modules.end() && !(known->second.stamp == stamp)){
+            __cv_modules.erase(known);
+            known = __cv_modules.end();
+        }
+        if(known != __cv_modules.end()){
+            // Copied, running the module may import other modules and rehash the registry
+            root = known->second.root;
+            parsed = true;
+        }
+    }
+
+    // Parsed without the lock. If another thread got there first its tree is the one kept
+    if(!parsed){
+        root = CV::LoadTree(fname, cursor);
+        if(cursor->error){
+            return ctx->buildNil();
+        }
+        for(auto &token : root){
+            __cv_share(token.get());
+        }
+        std::lock_guard<std::mutex> lock(__cv_modules_mutex);
+        auto known = __cv_modules.emplace(key, __cv_module{stamp, root}).first;
+        if(!(known->second.stamp == stamp)){
+            known->second = __cv_module{stamp, root};
+        }
     }
 
     auto result = ctx->buildNil();
 
     for(int i = 0; i < static_cast<int>(root.size()); ++i){
-        auto cf = std::make_shared<CV::ControlFlow>();
+        auto cf = CV::MakeRef<CV::ControlFlow>();
         cf->state = CV::ControlFlowState::CONTINUE;
 
         result = CV::Interpret(root[i], cursor, cf, ctx);
@@ -3408,21 +6846,31 @@ std::shared_ptr<CV::Data> CV::Import(
         }
     }
 
-    return result ? result : ctx->buildNil();
+    result = result ? result : ctx->buildNil();
+
+    if(!__cv_module_results_gone){
+        __cv_module_results.contexts[ctx->id][key] = __cv_module_result{stamp, result};
+        ctx->imported = true;
+    }
+
+    return result;
 }
 
 #define CV_IMPORT_LIBRARY_ENTRY_POINT_ARGS \
-    const std::shared_ptr<CV::Context> &ctx, \
-    const std::shared_ptr<CV::Cursor> &cursor
+    const CV::Ref<CV::Context> &ctx, \
+    const CV::Ref<CV::Cursor> &cursor
 
-std::shared_ptr<CV::Data> CV::ImportDynamicLibrary(
+// Opens a library, runs its entry point and keeps what it registered. Leaves nothing open when it fails
+static bool __cv_open_dynamic_library(
     const std::string &path,
     const std::string &fname,
-    const CV::ContextType &ctx,
-    const CV::CursorType &cursor
+    const CV::CursorType &cursor,
+    __cv_dynamic_library &library
 ){
     using rlib = void (*)(CV_IMPORT_LIBRARY_ENTRY_POINT_ARGS);
 
+    auto scratch = CV::MakeRef<CV::Context>();
+
 #if (_CV_PLATFORM == _CV_PLATFORM_TYPE_LINUX) || (_CV_PLATFORM == _CV_PLATFORM_TYPE_OSX)
 
     void *handle = dlopen(path.c_str(), RTLD_LAZY);
@@ -3433,7 +6881,7 @@ std::shared_ptr<CV::Data> CV::ImportDynamicLibrary(
             "Failed to load dynamic library '"+fname+"': "+std::string(err ? err : "unknown error"),
             cursor->line
         );
-        return ctx->buildNil();
+        return false;
     }
 
     dlerror(); // clear previous error
@@ -3447,68 +6895,90 @@ std::shared_ptr<CV::Data> CV::ImportDynamicLibrary(
             cursor->line
         );
         dlclose(handle);
-        return ctx->buildNil();
+        return false;
     }
 
-    (*registerlibrary)(ctx, cursor);
+    (*registerlibrary)(scratch, cursor);
     if(cursor->error){
         dlclose(handle);
-        return ctx->buildNil();
-    }
-
-    auto id = GEN_ID();
-    {
-        std::lock_guard<std::mutex> lock(__cv_loaded_dynamic_libs_mutex);
-        __cv_loaded_dynamic_libs[id] = {handle, path};
+        return false;
     }
 
-    return std::static_pointer_cast<CV::Data>(ctx->buildNumber(id));
-
 #elif (_CV_PLATFORM == _CV_PLATFORM_TYPE_WINDOWS)
 
-    HMODULE hdll = LoadLibraryA(path.c_str());
-    if(hdll == NULL){
+    HMODULE handle = LoadLibraryA(path.c_str());
+    if(handle == NULL){
         cursor->setError(
             CV_ERROR_MSG_LIBRARY_NOT_VALID,
             "Failed to load dynamic library '"+fname+"'",
             cursor->line
         );
-        return ctx->buildNil();
+        return false;
     }
 
-    auto entry = reinterpret_cast<rlib>(GetProcAddress(hdll, "_CV_REGISTER_LIBRARY"));
+    auto entry = reinterpret_cast<rlib>(GetProcAddress(handle, "_CV_REGISTER_LIBRARY"));
     if(entry == NULL){
         cursor->setError(
             CV_ERROR_MSG_LIBRARY_NOT_VALID,
             "Failed to find '_CV_REGISTER_LIBRARY' in '"+fname+"'",
             cursor->line
         );
-        FreeLibrary(hdll);
-        return ctx->buildNil();
+        FreeLibrary(handle);
+        return false;
     }
 
-    entry(ctx, cursor);
+    entry(scratch, cursor);
     if(cursor->error){
-        FreeLibrary(hdll);
-        return ctx->buildNil();
-    }
-
-    auto id = GEN_ID();
-    {
-        std::lock_guard<std::mutex> lock(__cv_loaded_dynamic_libs_mutex);
-        __cv_loaded_dynamic_libs[id] = {hdll, path};
+        FreeLibrary(handle);
+        return false;
     }
 
-    return std::static_pointer_cast<CV::Data>(ctx->buildNumber(id));
-
 #else
 
+    (void)path;
+    (void)fname;
+    (void)library;
+    (void)scratch;
     cursor->setError(
         CV_ERROR_MSG_LIBRARY_NOT_VALID,
         "Dynamic libraries are not supported on this platform",
         1
     );
-    return ctx->buildNil();
+    return false;
+
+#endif
 
+#if (_CV_PLATFORM == _CV_PLATFORM_TYPE_LINUX) || (_CV_PLATFORM == _CV_PLATFORM_TYPE_OSX) || (_CV_PLATFORM == _CV_PLATFORM_TYPE_WINDOWS)
+    library.id = GEN_ID();
+    library.handle = handle;
+    library.table.assign(scratch->data.begin(), scratch->data.end());
+    return true;
 #endif
+}
+
+CV::Ref<CV::Data> CV::ImportDynamicLibrary(
+    const std::string &path,
+    const std::string &fname,
+    const CV::ContextType &ctx,
+    const CV::CursorType &cursor
+){
+    std::lock_guard<std::mutex> lock(__cv_loaded_dynamic_libs_mutex);
+
+    auto key = __cv_module_key(path);
+    auto known = __cv_loaded_dynamic_libs.find(key);
+    if(known == __cv_loaded_dynamic_libs.end()){
+        __cv_dynamic_library library;
+        if(!__cv_open_dynamic_library(path, fname, cursor, library)){
+            return ctx->buildNil();
+        }
+        known = __cv_loaded_dynamic_libs.emplace(key, std::move(library)).first;
+    }
+
+    // Binding through setNamed keeps the inline name caches honest
+    for(auto &entry : known->second.table){
+        auto &value = entry.second;
+        ctx->setNamed(entry.first, value->type == CV::DataType::FUNCTION ? value : ctx->copy(value));
+    }
+
+    return CV::CastRef<CV::Data>(ctx->buildNumber(known->second.id));
 }
\ No newline at end of file
@@ -3,13 +3,17 @@
 
     #include <vector>
     #include <cctype>
+    #include <cstdint>
     #include <unordered_map>
+    #include <unordered_set>
     #include <memory>
     #include <thread>
     #include <set>
     #include <string>
     #include <functional>
     #include <mutex>
+    #include <atomic>
+    #include <type_traits>
 
     #define CV_DEFAULT_NUMBER_TYPE double
     typedef CV_DEFAULT_NUMBER_TYPE CV_NUMBER;
@@ -34,6 +38,238 @@
 
     namespace CV {
 
+        ////////////////////////////
+        //// REFERENCES
+        ///////////////////////////
+
+        /*
+            Values, contexts, tokens and the rest of what the runtime hands around count their own references. A
+            count belongs to the thread that built the object and goes up and down with plain loads and stores,
+            until the object is shared (CV::Share) for other threads to hold too: from then on it's atomic.
+            Immortal ones (builtins, constants) aren't counted at all. What the count reaches zero on is given
+            back through destroy(), unless it's owned by a std::shared_ptr from outside (KEPT): that one is let go
+        */
+        struct Counted {
+            static const uint32_t SHARED = 1u << 31;
+            static const uint32_t IMMORTAL = 1u << 30;
+            static const uint32_t KEPT = 1u << 29;
+            static const uint32_t COUNT = KEPT - 1;
+
+            mutable std::atomic<uint32_t> refs;
+
+            Counted() : refs(0) {}
+            Counted(const Counted&) : refs(0) {}
+            Counted &operator=(const Counted&){ return *this; }
+            virtual ~Counted(){}
+
+            void retain() const {
+                auto n = refs.load(std::memory_order_relaxed);
+                if(n < IMMORTAL){
+                    refs.store(n + 1, std::memory_order_relaxed);
+                }else{
+                    retainShared();
+                }
+            }
+
+            void release() const {
+                auto n = refs.load(std::memory_order_relaxed);
+                if(n > 1 && n < IMMORTAL){
+                    refs.store(n - 1, std::memory_order_relaxed);
+                }else{
+                    releaseLast();
+                }
+            }
+
+            // Immortal objects report as many references as there can be, nothing ever holds them alone
+            uint32_t count() const {
+                auto n = refs.load(std::memory_order_relaxed);
+                return n & IMMORTAL ? COUNT : n & COUNT;
+            }
+
+            bool shared() const {
+                return refs.load(std::memory_order_relaxed) >= IMMORTAL;
+            }
+
+            // Only this object, CV::Share() takes care of whatever it reaches
+            void share() const {
+                refs.fetch_or(SHARED, std::memory_order_relaxed);
+            }
+
+            void immortalize() const {
+                refs.fetch_or(IMMORTAL, std::memory_order_relaxed);
+            }
+
+            virtual void destroy() const {
+                delete this;
+            }
+
+            // Kept out of the way of the counts above, which are the common case by far
+            void retainShared() const;
+            void releaseLast() const;
+
+            // Pooled, see VALUE POOLS
+            static void *operator new(std::size_t size);
+            static void operator delete(void *p, std::size_t size);
+        };
+
+        inline void RefRetain(const CV::Counted *p){
+            p->retain();
+        }
+
+        inline void RefRelease(const CV::Counted *p){
+            p->release();
+        }
+
+        // Not defined where the header is, counted out of line
+        struct Bytecode;
+        void RefRetain(const CV::Bytecode *p);
+        void RefRelease(const CV::Bytecode *p);
+
+        // Deleter of every std::shared_ptr made out of a Ref, what tells them apart from any other
+        struct RefDeleter {
+            template<typename P>
+            void operator()(P *p) const {
+                RefRelease(p);
+            }
+        };
+
+        /*
+            Holds 'owner', a std::shared_ptr that didn't come from a Ref, for as long as any Ref holds the object it
+            owns: one more reference, counted atomically. The last one to go lets go of 'owner' instead of destroying
+        */
+        void RefKeep(const CV::Counted *p, std::shared_ptr<const void> owner);
+
+        template<typename T>
+        struct Ref {
+            typedef T element_type;
+
+            Ref() : ptr(nullptr) {}
+            Ref(std::nullptr_t) : ptr(nullptr) {}
+            // Takes one more reference: any counted object can be held again from a plain pointer to it
+            explicit Ref(T *p) : ptr(p) {
+                if(ptr){
+                    RefRetain(ptr);
+                }
+            }
+            Ref(const Ref &other) : ptr(other.ptr) {
+                if(ptr){
+                    RefRetain(ptr);
+                }
+            }
+            Ref(Ref &&other) noexcept : ptr(other.ptr) {
+                other.ptr = nullptr;
+            }
+            template<typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+            Ref(const Ref<U> &other) : ptr(other.get()) {
+                if(ptr){
+                    RefRetain(ptr);
+                }
+            }
+            template<typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+            Ref(Ref<U> &&other) noexcept : ptr(other.detach()) {}
+            // From a native module. One made out of a Ref holds a reference of its own, any other one is kept alive
+            template<typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+            Ref(const std::shared_ptr<U> &other) : ptr(other.get()) {
+                if(!ptr){
+                    return;
+                }
+                if(std::get_deleter<CV::RefDeleter>(other)){
+                    RefRetain(ptr);
+                }else{
+                    RefKeep(ptr, other);
+                }
+            }
+            ~Ref(){
+                if(ptr){
+                    RefRelease(ptr);
+                }
+            }
+
+            Ref &operator=(const Ref &other){
+                Ref(other).swap(*this);
+                return *this;
+            }
+            Ref &operator=(Ref &&other) noexcept {
+                Ref(std::move(other)).swap(*this);
+                return *this;
+            }
+            Ref &operator=(std::nullptr_t){
+                reset();
+                return *this;
+            }
+
+            /*
+                For a native module: the std::shared_ptr holds one reference for as long as it lives. It may end up
+                on any thread, so the object is counted atomically from then on
+            */
+            template<typename U, typename = typename std::enable_if<std::is_convertible<T*, U*>::value>::type>
+            operator std::shared_ptr<U>() const {
+                if(!ptr){
+                    return nullptr;
+                }
+                ptr->share();
+                RefRetain(ptr);
+                return std::shared_ptr<U>(ptr, CV::RefDeleter());
+            }
+
+            T *get() const { return ptr; }
+            T &operator*() const { return *ptr; }
+            T *operator->() const { return ptr; }
+            explicit operator bool() const { return ptr != nullptr; }
+            long use_count() const { return ptr ? static_cast<long>(ptr->count()) : 0; }
+
+            void reset(){
+                Ref().swap(*this);
+            }
+            void swap(Ref &other) noexcept {
+                std::swap(ptr, other.ptr);
+            }
+            // Takes over a reference someone already counted (what detach() hands out)
+            static Ref adopt(T *p){
+                Ref ref;
+                ref.ptr = p;
+                return ref;
+            }
+            // Hands the reference over to the caller, who has to give it back
+            T *detach(){
+                auto p = ptr;
+                ptr = nullptr;
+                return p;
+            }
+
+        private:
+            T *ptr;
+        };
+
+        template<typename T, typename U>
+        inline bool operator==(const Ref<T> &a, const Ref<U> &b){ return a.get() == b.get(); }
+        template<typename T, typename U>
+        inline bool operator!=(const Ref<T> &a, const Ref<U> &b){ return a.get() != b.get(); }
+        template<typename T>
+        inline bool operator==(const Ref<T> &a, std::nullptr_t){ return !a; }
+        template<typename T>
+        inline bool operator==(std::nullptr_t, const Ref<T> &a){ return !a; }
+        template<typename T>
+        inline bool operator!=(const Ref<T> &a, std::nullptr_t){ return static_cast<bool>(a); }
+        template<typename T>
+        inline bool operator!=(std::nullptr_t, const Ref<T> &a){ return static_cast<bool>(a); }
+
+        template<typename T, typename... Args>
+        inline Ref<T> MakeRef(Args&&... args){
+            return Ref<T>(new T(std::forward<Args>(args)...));
+        }
+
+        // static_pointer_cast for references
+        template<typename T, typename U>
+        inline Ref<T> CastRef(const Ref<U> &ref){
+            return Ref<T>(static_cast<T*>(ref.get()));
+        }
+
+        template<typename T, typename U>
+        inline Ref<T> CastRef(Ref<U> &&ref){
+            return Ref<T>::adopt(static_cast<T*>(ref.detach()));
+        }
+
         static const CV_NUMBER VERSION[3] = { 1, 0, 0 };
         static const std::string RELEASE = "April 6th 2026"; 
 
@@ -113,7 +349,7 @@
         struct Cursor;
         struct Data;
         struct Context;
-        typedef std::shared_ptr<Cursor> CursorType;
+        typedef CV::Ref<Cursor> CursorType;
 
         ////////////////////////////
         //// TYPES
@@ -160,101 +396,328 @@
             }
         }
 
+        ////////////////////////////
+        //// SYMBOLS
+        ///////////////////////////
+
+        // Names found in source are interned once into symbols, so contexts and parameters hash and compare integers
+        // instead of strings. Symbols live for the whole process, are the same across every runtime and thread in it
+        // and never go away, so store members (which may be named by whatever data they came from) don't use them
+        typedef uint32_t Symbol;
+        CV::Symbol Intern(const std::string &name);
+        const std::string &SymbolName(CV::Symbol symbol);
+
         struct Cursor;
         struct Token;
         struct Data;
         struct Context;
+        struct Bytecode;
 
-        struct Data {
+        struct Data : CV::Counted {
             CV::DataType type;
+            // Watched by the cycle collector: a list or store got put inside it at some point
+            bool tracked;
             Data();
-            virtual std::shared_ptr<CV::Data> unwrap(){ return std::make_shared<CV::Data>(); };
+            Data(const Data &other);
+            virtual ~Data();
+            virtual CV::Ref<CV::Data> unwrap();
         };
 
-        struct DataNumber : Data, std::enable_shared_from_this<CV::DataNumber> {
+        struct DataNumber : Data {
             CV_NUMBER v;
             DataNumber();
-            std::shared_ptr<CV::Data> unwrap() override;
+            CV::Ref<CV::Data> unwrap() override;
         };      
         
-        struct DataString : Data, std::enable_shared_from_this<CV::DataString> {
+        struct DataString : Data {
             std::string v;
             DataString();
-            std::shared_ptr<CV::Data> unwrap() override;
+            CV::Ref<CV::Data> unwrap() override;
         };   
         
-        struct DataList : Data, std::enable_shared_from_this<CV::DataList> {
-            std::vector<std::shared_ptr<CV::Data>> v;
+        /*
+            Items of a LIST. The last ones (fewer than 32) are held right here, everything before them in chunks of
+            32 that copies made by 'cc' share instead of copying item by item. A list that hands out or changes an
+            item of a chunk some other list shares takes a copy of that chunk first, items copied as 'cc' would,
+            so nothing done through one list shows through the other
+        */
+        struct ListChunk : CV::Counted {
+            static const std::size_t SIZE = 32;
+            CV::Ref<CV::Data> items[SIZE];
+            // An item might also be held from outside the chunk (handed out, or put in from somewhere else)
+            bool exposed;
+            ListChunk();
+        };
+
+        struct ListItems {
+            std::vector<CV::Ref<CV::ListChunk>> chunks;
+            std::vector<CV::Ref<CV::Data>> tail;
+
+            struct const_iterator {
+                const ListItems *items;
+                std::size_t i;
+                const CV::Ref<CV::Data> &operator*() const { return (*items)[i]; }
+                const_iterator &operator++(){ ++i; return *this; }
+                bool operator!=(const const_iterator &other) const { return i != other.i; }
+            };
+
+            std::size_t size() const { return chunks.size() * ListChunk::SIZE + tail.size(); }
+            bool empty() const { return chunks.empty() && tail.empty(); }
+            // Only for looking at an item. Anything handed out or changed must come through the non const one
+            const CV::Ref<CV::Data> &operator[](std::size_t i) const;
+            const CV::Ref<CV::Data> &operator[](std::size_t i);
+            const CV::Ref<CV::Data> &back();
+            void push_back(const CV::Ref<CV::Data> &item);
+            void pop_back();
+            void clear();
+            // What 'cc' makes of the list: every chunk that's safe to share is shared, the rest copied
+            ListItems copy() const;
+            const_iterator begin() const { return {this, 0}; }
+            const_iterator end() const { return {this, size()}; }
+        };
+
+        struct DataList : Data {
+            CV::ListItems v;
             DataList();
-            std::shared_ptr<CV::Data> unwrap() override;
+            CV::Ref<CV::Data> unwrap() override;
         };    
         
-        struct DataStore : Data, std::enable_shared_from_this<CV::DataStore> {
-            std::unordered_map<std::string, std::shared_ptr<CV::Data>> v;
+        /*
+            Members of a STORE. 'cc' moves them to a block the store and its copy share instead of copying them. While
+            shared, a member either store hands out or is given goes into that store's own (copied as 'cc' would, if
+            handed out) and hides the shared one from then on. A store left the only holder takes them all back
+        */
+        struct StoreMembers : CV::Counted {
+            std::unordered_map<std::string, CV::Ref<CV::Data>> items;
+        };
+
+        struct StoreItems {
+            typedef std::unordered_map<std::string, CV::Ref<CV::Data>> Map;
+            Map own;
+            CV::Ref<CV::StoreMembers> shared;
+            // Names in 'own' that 'shared' doesn't have
+            std::size_t added;
+            // A member of its own might also be held from outside (handed out, or put in from somewhere else)
+            bool exposed;
+
+            struct const_iterator {
+                const StoreItems *items;
+                Map::const_iterator it;
+                bool inOwn;
+                const Map::value_type *current;
+                const Map::value_type &operator*() const { return *current; }
+                const Map::value_type *operator->() const { return current; }
+                const_iterator &operator++();
+                bool operator!=(const const_iterator &other) const { return inOwn != other.inOwn || it != other.it; }
+                bool operator==(const const_iterator &other) const { return !(*this != other); }
+                void settle();
+            };
+
+            StoreItems();
+            std::size_t size() const { return shared ? shared->items.size() + added : own.size(); }
+            bool empty() const { return size() == 0; }
+            std::size_t count(const std::string &name) const;
+            // Hands the member out, anything only looked at goes through the iterators instead
+            const CV::Ref<CV::Data> &member(const std::string &name);
+            void set(const std::string &name, const CV::Ref<CV::Data> &value);
+
+            // The map-like 'store->v[name]' modules have always used: reading hands the member out, assigning sets it
+            struct Member {
+                StoreItems *items;
+                std::string name;
+                const CV::Ref<CV::Data> &get() const { return items->member(name); }
+                operator const CV::Ref<CV::Data>&() const { return get(); }
+                operator std::shared_ptr<CV::Data>() const { return get(); }
+                CV::Data *operator->() const { return get().get(); }
+                Member &operator=(const CV::Ref<CV::Data> &value){
+                    items->set(name, value);
+                    return *this;
+                }
+                Member &operator=(const Member &other){
+                    items->set(name, other.get());
+                    return *this;
+                }
+            };
+            Member operator[](const std::string &name){ return Member{this, name}; }
+            // Every member made this store's own, for handing them all out
+            Map &owned();
+            void clear();
+            // What 'cc' makes of the store: members shared from then on if it's safe to, copied otherwise
+            StoreItems copy();
+            const_iterator begin() const;
+            const_iterator end() const;
+            // Looks at a member without handing it out, end() if there's none
+            const_iterator find(const std::string &name) const;
+        };
+
+        struct DataStore : Data {
+            CV::StoreItems v;
             DataStore();
-            std::shared_ptr<CV::Data> unwrap() override;
+            bool has(const std::string &name);
+            CV::Ref<CV::Data> get(const std::string &name);
+            void set(const std::string &name, const CV::Ref<CV::Data> &value);
+            CV::Ref<CV::Data> unwrap() override;
         };   
 
-        struct DataFunction : Data, std::enable_shared_from_this<CV::DataFunction> {
-            std::vector<std::string> params;
+        /*
+            What native modules register. Values come and go as std::shared_ptr the way they always have, each one
+            handed over is held by it for as long as the std::shared_ptr lives
+        */
+        typedef std::function<std::shared_ptr<CV::Data>(
+            const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
+            const CV::Ref<CV::Context> &ctx,
+            const CV::Ref<CV::Cursor> &cursor,
+            const CV::Ref<CV::Token> &token
+        )> NativeFunction;
+
+        struct DataFunction : Data {
+            std::vector<CV::Symbol> params;
             bool isLambda;
             bool isVariadic;
-            std::shared_ptr<CV::Token> body;
-            std::function<std::shared_ptr<CV::Data>(
-                const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-                const std::shared_ptr<CV::Context> &ctx,
-                const std::shared_ptr<CV::Cursor> &cursor,
-                const std::shared_ptr<CV::Token> &token
+            CV::Ref<CV::Token> body;
+            std::function<CV::Ref<CV::Data>(
+                const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+                const CV::Ref<CV::Context> &ctx,
+                const CV::Ref<CV::Cursor> &cursor,
+                const CV::Ref<CV::Token> &token
             )> lambda;
+            // Set when the function was defined by the VM: its body is compiled at 'entry' in 'code'
+            CV::Ref<CV::Bytecode> code;
+            int entry;
+            // Binding plan: slot of every parameter by name, filled by plan() once 'params' is final
+            std::unordered_map<CV::Symbol, int> paramIndex;
+            // Optional plain number version of 'lambda' the VM uses when every argument is a number. Returning
+            // false hands the call back to 'lambda', which is also the one reporting errors
+            bool (*kernel)(const CV_NUMBER *args, int n, CV_NUMBER &out);
             DataFunction();
-            std::shared_ptr<CV::Data> unwrap() override;
+            void plan();
+            CV::Ref<CV::Data> unwrap() override;
         }; 
         
-        struct DataProxy : Data, std::enable_shared_from_this<CV::DataProxy> {
-            std::string pname;
+        struct DataProxy : Data {
+            // Only meaningful for NAMER proxies
+            CV::Symbol pname;
             int ptype;
-            std::shared_ptr<CV::Data> target;
+            CV::Ref<CV::Data> target;
             DataProxy();
-            std::shared_ptr<CV::Data> unwrap() override;
+            CV::Ref<CV::Data> unwrap() override;
         };         
 
-        struct Context : Data, std::enable_shared_from_this<CV::Context> {
-            std::shared_ptr<Context> head;
-            std::unordered_map<std::string, std::shared_ptr<CV::Data>> data;
-            std::set<std::string> namedNames;
+        /*
+            Inline value: nil and numbers are held right here and never touch the heap, anything else is a
+            reference to its heap object. Contexts, lists and libraries keep exchanging CV::Ref<CV::Data>,
+            box() is the way back into them (references come back as the very same object)
+        */
+        struct Value {
+            CV::DataType type;
+            CV_NUMBER number;
+            CV::Ref<CV::Data> ref;
+            Value();
+            Value(CV_NUMBER number);
+            Value(const CV::Ref<CV::Data> &ref);
+            Value(CV::Ref<CV::Data> &&ref);
+            bool isImmediate() const;
+            // Only meaningful for NUMBER, wherever the number lives
+            CV_NUMBER toNumber() const;
+            CV::Ref<CV::Data> box() const;
+        };
+
+        /*
+            Names bound in a context, by symbol. Modules index it with strings the way they always have: reading
+            looks the name up in that context alone, assigning binds it through Context::setNamed
+        */
+        struct ContextData : std::unordered_map<CV::Symbol, CV::Ref<CV::Data>> {
+            typedef std::unordered_map<CV::Symbol, CV::Ref<CV::Data>> Map;
+            using Map::operator[];
+            using Map::count;
+
+            struct Binding {
+                Context *owner;
+                std::string name;
+                const CV::Ref<CV::Data> &get() const;
+                operator const CV::Ref<CV::Data>&() const { return get(); }
+                operator std::shared_ptr<CV::Data>() const { return get(); }
+                CV::Data *operator->() const { return get().get(); }
+                Binding &operator=(const CV::Ref<CV::Data> &value);
+                Binding &operator=(const Binding &other);
+            };
+
+            // Set by the Context it's in, copying the names over doesn't move them to another context
+            Context *owner;
+            ContextData() : owner(NULL) {}
+            ContextData(const ContextData &other) : Map(other), owner(NULL) {}
+            ContextData &operator=(const ContextData &other){
+                Map::operator=(other);
+                return *this;
+            }
+            Binding operator[](const std::string &name){ return Binding{owner, name}; }
+            std::size_t count(const std::string &name) const;
+        };
+
+        struct Context : Data {
+            CV::Ref<Context> head;
+            CV::ContextData data;
+            std::unordered_set<CV::Symbol> namedNames;
+            // Unique for the lifetime of the process, inline name caches are keyed by it
+            uint64_t id;
+            // Forked at least once, or above one that was: a fork copies what it reads from here before anything can
+            // change it. Other threads may be walking it, so it's never marked as seen either
+            std::atomic<bool> frozen;
+            // Made by fork()
+            bool isFork;
+            // Walked through by an inline name cache, binding a new name here has to invalidate the caches
+            bool seen;
+            // Ran a module, whose result is kept for it until it goes
+            bool imported;
             Context();
-            std::pair<std::shared_ptr<CV::Context>, std::shared_ptr<CV::Data>> getNamed(const std::string &name);
-            std::shared_ptr<CV::Context> buildContext(bool inherit = true);
-            std::shared_ptr<CV::Data> buildNil();
-            std::shared_ptr<CV::DataNumber> buildNumber(CV_NUMBER v = 0);
-            std::shared_ptr<CV::DataString> buildString(const std::string &v = "");
-            std::shared_ptr<CV::DataList> buildList();
-            std::shared_ptr<CV::DataStore> buildStore();
-            std::shared_ptr<CV::Data> copy(const std::shared_ptr<CV::Data> &target);
-            std::shared_ptr<CV::Data> unwrap() override;
+            ~Context();
+            std::pair<CV::Ref<CV::Context>, CV::Ref<CV::Data>> getNamed(CV::Symbol name);
+            std::pair<CV::Ref<CV::Context>, CV::Ref<CV::Data>> getNamed(const std::string &name);
+            // Binds a name and invalidates the inline name caches that could have seen this context. Returns what got bound
+            const CV::Ref<CV::Data> &setNamed(CV::Symbol name, const CV::Ref<CV::Data> &value);
+            const CV::Ref<CV::Data> &setNamed(const std::string &name, const CV::Ref<CV::Data> &value);
+            CV::Ref<CV::Context> buildContext(bool inherit = true);
+            /*
+                A child that sees everything bound here and never changes it: 'let' binds into the child, and a
+                number, string, list or store bound here is copied into the child the first time the child reads
+                it, so whatever changes it in place ('mut', '++', '>>'...) changes the child's copy. Lists and
+                stores share their chunks with the original until either side writes. Dropping the child drops
+                everything a request did
+            */
+            CV::Ref<CV::Context> fork();
+            CV::Ref<CV::Data> buildNil();
+            CV::Ref<CV::DataNumber> buildNumber(CV_NUMBER v = 0);
+            CV::Ref<CV::DataString> buildString(const std::string &v = "");
+            CV::Ref<CV::DataList> buildList();
+            CV::Ref<CV::DataStore> buildStore();
+            CV::Ref<CV::Data> copy(const CV::Ref<CV::Data> &target);
+            CV::Ref<CV::Data> unwrap() override;
             void registerFunction(
                 const std::string &name,
                 const std::vector<std::string> &params,
-                const std::function<std::shared_ptr<CV::Data>(
-                    const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-                    const std::shared_ptr<CV::Context> &ctx,
-                    const std::shared_ptr<CV::Cursor> &cursor,
-                    const std::shared_ptr<CV::Token> &token
+                const std::function<CV::Ref<CV::Data>(
+                    const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+                    const CV::Ref<CV::Context> &ctx,
+                    const CV::Ref<CV::Cursor> &cursor,
+                    const CV::Ref<CV::Token> &token
                 )> &lambda
             );
 
             void registerFunction(
                 const std::string &name,
-                const std::function<std::shared_ptr<CV::Data>(
-                    const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
-                    const std::shared_ptr<CV::Context> &ctx,
-                    const std::shared_ptr<CV::Cursor> &cursor,
-                    const std::shared_ptr<CV::Token> &token
+                const std::function<CV::Ref<CV::Data>(
+                    const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &args,
+                    const CV::Ref<CV::Context> &ctx,
+                    const CV::Ref<CV::Cursor> &cursor,
+                    const CV::Ref<CV::Token> &token
                 )> &lambda
             );            
 
+            void registerFunction(const std::string &name, const std::vector<std::string> &params, const CV::NativeFunction &lambda);
+            void registerFunction(const std::string &name, const CV::NativeFunction &lambda);
+
         };  
-        typedef std::shared_ptr<CV::Context> ContextType;
+        typedef CV::Ref<CV::Context> ContextType;
         
         ////////////////////////////
         //// PARSING
@@ -291,25 +754,25 @@
             };
         }
         
-        struct ControlFlow {
+        struct ControlFlow : CV::Counted {
             int state;
-            std::shared_ptr<CV::Data> payload;
+            CV::Ref<CV::Data> payload;
             ControlFlow(){
                 this->state = CV::ControlFlowState::CONTINUE;
             }
         };   
         
-        typedef std::shared_ptr<CV::ControlFlow> ControlFlowType;
+        typedef CV::Ref<CV::ControlFlow> ControlFlowType;
 
         struct Token;
-        struct Cursor {
+        struct Cursor : CV::Counted {
             std::mutex accessMutex;
             std::string message;
             std::string title;
             bool autoprint;
             bool error;
             unsigned line;
-            std::shared_ptr<CV::Token> subject;
+            CV::Ref<CV::Token> subject;
             bool shouldExit;
             bool used;
             Cursor();
@@ -317,26 +780,103 @@
             bool raise();
             void reset();
             void clear();
-            void setError(const std::string &title, const std::string &message, const std::shared_ptr<CV::Token> &subject = NULL);
+            void setError(const std::string &title, const std::string &message, const CV::Ref<CV::Token> &subject = NULL);
             void setError(const std::string &title, const std::string &message, int line);
         };
 
 
-        struct Token {
+        namespace TokenKind {
+            enum TokenKind : int {
+                NAME,
+                NUMBER,
+                STRING,
+                NIL,
+                PREFIXED
+            };
+        }
+
+        // Verdict on the name of a NAMER token, reached once by Token::refresh() and reported when it runs
+        namespace NamerCheck {
+            enum NamerCheck : int {
+                VALID,
+                UNSCANNABLE,
+                COMPLEX,
+                INVALID,
+                RESERVED
+            };
+        }
+
+        // What Interpret does with a token, resolved once by Token::refresh()
+        namespace Opcode {
+            enum Opcode : int {
+                NAME,
+                GROUP,
+                B_STORE,
+                B_LIST,
+                SKIP,
+                RETURN,
+                YIELD,
+                FN,
+                CC,
+                MUT,
+                IMPORT,
+                IMPORT_DYNAMIC_LIBRARY,
+                LET,
+                IF,
+                WHILE,
+                FOR,
+                FOREACH,
+                TRY,
+                TEMPLATE,
+                EXPANDER,
+                NAMER,
+                NIL,
+                NUMBER,
+                STRING
+            };
+        }
+
+        struct Token : CV::Counted {
             std::string first;
             unsigned line;
             bool solved;
             bool complex;
-            std::vector<std::shared_ptr<Token>> inner;
+            int opcode;
+            // Decoded by refresh(): NUMBER and STRING literals keep their payload ready to be built, NAMER tokens
+            // keep their name in 'literal' along with how it checked out. Names (plain or NAMER) come interned too
+            int kind;
+            CV_NUMBER number;
+            std::string literal;
+            int namerCheck;
+            CV::Symbol symbol;
+            // Body of a '?' prefix, parsed once by refresh(). Left empty if there's nothing to run or it doesn't parse
+            std::vector<CV::Ref<Token>> guarded;
+            std::vector<CV::Ref<Token>> inner;
+            // What a parse carved the token out of, kept alive by every token in it. Null for tokens built on their own
+            CV::Ref<CV::Counted> arena;
             Token();
             Token(const std::string &first, unsigned line);    
-            std::shared_ptr<CV::Token> emptyCopy();
-            std::shared_ptr<CV::Token> copy();
+            CV::Ref<CV::Token> emptyCopy();
+            CV::Ref<CV::Token> copy();
             std::string str() const;
             void refresh();
+            void destroy() const override;
         };
 
-        typedef std::shared_ptr<Token> TokenType;
+        typedef CV::Ref<Token> TokenType;
+
+        ////////////////////////////
+        //// VM
+        ///////////////////////////
+
+        namespace Engine {
+            enum Engine : int {
+                INTERPRETER,
+                VM
+            };
+        }
+
+        typedef CV::Ref<Bytecode> BytecodeType;
 
         ////////////////////////////
         //// TOOLS
@@ -368,12 +908,59 @@
             bool isInList(const std::string &v, const std::vector<std::string> &list);   
         }
 
+        struct NameCacheStats {
+            uint64_t hits;
+            uint64_t misses;
+        };
+
+        // Lookups done by the calling thread
+        CV::NameCacheStats GetNameCacheStats();
+        uint64_t GetDataAllocations();
+
+        struct CollectorStats {
+            uint64_t collections;
+            // Containers freed by breaking the cycles they were part of
+            uint64_t collected;
+            // Containers being watched because a list or store got put inside them
+            uint64_t tracked;
+            // Data objects (contexts included) alive right now, in every thread
+            uint64_t live;
+            // In seconds
+            double lastPause;
+            double maxPause;
+            double totalPause;
+        };
+
+        // The calling thread's collector, values are only ever collected by the thread that watches them
+        CV::CollectorStats GetCollectorStats();
+        /*
+            Collections run by themselves once 'pending' containers started being watched since the last one and
+            that's at least 'growth' percent of the containers that survived it. 0 'pending' turns them off
+        */
+        void SetCollectorThresholds(uint64_t pending, uint64_t growth = 25);
+        // Frees every cycle of lists, stores, proxies and contexts nothing else refers to. Returns how many containers it freed
+        uint64_t Collect();
+
         void SetUseColor(bool v);
+        // Whether importing a '.cv' a context already ran hands back its earlier result instead of running it again
+        void SetModuleReuse(bool v);
         std::string GetPrompt();  
-        std::string DataToText(const std::shared_ptr<CV::Data> &t);      
+        std::string DataToText(const CV::Ref<CV::Data> &t);      
 
+        /*
+            Lets other threads hold a value and everything it reaches (a context and what's bound in it, a list and
+            its items...): references to them are counted atomically from then on. Until then whatever a thread
+            builds is that thread's alone
+        */
+        void Share(const CV::Ref<CV::Data> &value);
+
+        // The process wide context holding every builtin, any number of threads may chain to it at once. Read only:
+        // never bind anything into it
+        CV::Ref<CV::Context> GetBuiltins();
+
+        // Makes the builtins reachable from a context by chaining the root of its chain to GetBuiltins()
         bool CoreSetup(
-            const std::shared_ptr<CV::Context> &ctx
+            const CV::Ref<CV::Context> &ctx
         );
 
         std::vector<CV::TokenType> BuildTree(
@@ -381,20 +968,80 @@
             const CV::CursorType &cursor
         );        
 
-        std::shared_ptr<CV::Data> Interpret(
+        // BuildTree for a script file, taking its tree from the precompiled '.cvc' next to it if that's up to date
+        std::vector<CV::TokenType> LoadTree(
+            const std::string &path,
+            const CV::CursorType &cursor
+        );
+
+        // Parses a script file and writes its tree to the '.cvc' next to it, for LoadTree to pick up
+        bool Precompile(
+            const std::string &path,
+            const CV::CursorType &cursor
+        );
+
+        CV::Ref<CV::Data> Interpret(
             const CV::TokenType &token,
             const CV::CursorType &cursor,
             const CV::ControlFlowType &cf,
             const CV::ContextType &ctx
         );
 
-        std::shared_ptr<CV::Data> Import(
+        // Compiles a root token for the VM. It never fails: whatever the compiler doesn't translate is
+        // handed over to Interpret when executed, so errors are reported the same way by both engines
+        CV::BytecodeType Compile(
+            const CV::TokenType &token
+        );
+
+        CV::Ref<CV::Data> Execute(
+            const CV::BytecodeType &code,
+            const CV::CursorType &cursor,
+            const CV::ControlFlowType &cf,
+            const CV::ContextType &ctx
+        );
+
+        // Compiles and runs a root token, the VM's counterpart of Interpret
+        CV::Ref<CV::Data> Execute(
+            const CV::TokenType &token,
+            const CV::CursorType &cursor,
+            const CV::ControlFlowType &cf,
+            const CV::ContextType &ctx
+        );
+
+        /*
+            A script parsed once, and compiled once for the VM, to be run any number of times against any contexts,
+            from any number of threads at once: nothing about it changes after BuildProgram, name caches are kept
+            per thread. A context several threads run against has to be shared (CV::Share) first
+        */
+        struct Program : CV::Counted {
+            int engine;
+            std::vector<CV::TokenType> root;
+            // One per root token, only for the VM
+            std::vector<CV::BytecodeType> code;
+
+            // Runs in a fork of 'ctx' holding the inputs: whatever the script binds or changes is gone afterwards
+            CV::Ref<CV::Data> run(
+                const CV::ContextType &ctx,
+                const std::vector<std::pair<std::string, CV::Ref<CV::Data>>> &inputs,
+                const CV::CursorType &cursor
+            ) const;
+        };
+        typedef CV::Ref<const CV::Program> ProgramType;
+
+        // Null if the source doesn't parse, with the error in 'cursor'
+        CV::ProgramType BuildProgram(
+            const std::string &source,
+            const CV::CursorType &cursor,
+            int engine = CV::Engine::INTERPRETER
+        );
+
+        CV::Ref<CV::Data> Import(
             const std::string &fname,
             const CV::ContextType &ctx,
             const CV::CursorType &cursor
         );
 
-        std::shared_ptr<CV::Data> ImportDynamicLibrary(
+        CV::Ref<CV::Data> ImportDynamicLibrary(
             const std::string &path,
             const std::string &fname,
             const CV::ContextType &ctx,
@@ -26,7 +26,7 @@ namespace {
     }
 
     static std::shared_ptr<CV::Data> __cv_file_unwrap(const std::shared_ptr<CV::Data> &d){
-        return d ? d->unwrap() : std::shared_ptr<CV::Data>(nullptr);
+        return d ? std::shared_ptr<CV::Data>(d->unwrap()) : nullptr;
     }
 
     static bool __cv_file_expect_exactly(
@@ -222,12 +222,12 @@ namespace {
     ){
         auto out = ctx->buildStore();
 
-        out->v["fileid"] = std::static_pointer_cast<CV::Data>(ctx->buildNumber(id));
-        out->v["filename"] = std::static_pointer_cast<CV::Data>(ctx->buildString(entry.filename));
-        out->v["path"] = std::static_pointer_cast<CV::Data>(ctx->buildString(entry.path));
-        out->v["file_path"] = std::static_pointer_cast<CV::Data>(ctx->buildString(entry.file_path));
-        out->v["extension"] = std::static_pointer_cast<CV::Data>(ctx->buildString(entry.extension));
-        out->v["mode"] = std::static_pointer_cast<CV::Data>(ctx->buildString(entry.mode));
+        out->v["fileid"] = ctx->buildNumber(id);
+        out->v["filename"] = ctx->buildString(entry.filename);
+        out->v["path"] = ctx->buildString(entry.path);
+        out->v["file_path"] = ctx->buildString(entry.file_path);
+        out->v["extension"] = ctx->buildString(entry.extension);
+        out->v["mode"] = ctx->buildString(entry.mode);
 
         return out;
     }
@@ -375,11 +375,11 @@ namespace {
             unsigned char byte = bytes[i];
             for(int b = 7; b >= 0; --b){
                 int bit = (byte >> b) & 1;
-                out->v.push_back(std::static_pointer_cast<CV::Data>(ctx->buildNumber(bit)));
+                out->v.push_back(ctx->buildNumber(bit));
             }
         }
 
-        return std::static_pointer_cast<CV::Data>(out);
+        return out;
     }
 
     static bool __cv_file_seek_abs(
@@ -563,7 +563,7 @@ namespace {
             __cv_file_handles[fileId].fp = nullptr;
         }
 
-        return std::static_pointer_cast<CV::Data>(ctx->buildNumber(1));
+        return ctx->buildNumber(1);
     }
 
     static std::shared_ptr<CV::Data> __CV_STD_FILE_WRITE(
@@ -634,7 +634,7 @@ namespace {
         }
 
         std::fflush(entry.fp);
-        return std::static_pointer_cast<CV::Data>(ctx->buildNumber(1));
+        return ctx->buildNumber(1);
     }
 
     static std::shared_ptr<CV::Data> __CV_STD_FILE_WRITE_AT(
@@ -706,7 +706,7 @@ namespace {
         }
 
         std::fflush(entry.fp);
-        return std::static_pointer_cast<CV::Data>(ctx->buildNumber(1));
+        return ctx->buildNumber(1);
     }
 
     static std::shared_ptr<CV::Data> __CV_STD_FILE_READ(
@@ -753,9 +753,7 @@ namespace {
             return __cv_file_bytes_to_bits(bytes, ctx);
         }
 
-        return std::static_pointer_cast<CV::Data>(
-            ctx->buildString(std::string(bytes.begin(), bytes.end()))
-        );
+        return ctx->buildString(std::string(bytes.begin(), bytes.end()));
     }
 
     static std::shared_ptr<CV::Data> __CV_STD_FILE_READ_AT(
@@ -810,9 +808,7 @@ namespace {
             return __cv_file_bytes_to_bits(bytes, ctx);
         }
 
-        return std::static_pointer_cast<CV::Data>(
-            ctx->buildString(std::string(bytes.begin(), bytes.end()))
-        );
+        return ctx->buildString(std::string(bytes.begin(), bytes.end()));
     }
 }
 
@@ -840,9 +836,7 @@ static std::shared_ptr<CV::Data> __CV_STD_FILE_EXISTS(
         return ctx->buildNil();
     }
 
-    return std::static_pointer_cast<CV::Data>(
-        ctx->buildNumber(exists ? 1 : 0)
-    );
+    return ctx->buildNumber(exists ? 1 : 0);
 }
 
 static std::shared_ptr<CV::Data> __CV_STD_FILE_GET_SIZE(
@@ -878,9 +872,7 @@ static std::shared_ptr<CV::Data> __CV_STD_FILE_GET_SIZE(
         return ctx->buildNil();
     }
 
-    return std::static_pointer_cast<CV::Data>(
-        ctx->buildNumber(static_cast<CV_NUMBER>(size))
-    );
+    return ctx->buildNumber(static_cast<CV_NUMBER>(size));
 }
 
 static std::shared_ptr<CV::Data> __CV_STD_FILE_GET_LAST_MODIFIED(
@@ -916,9 +908,7 @@ static std::shared_ptr<CV::Data> __CV_STD_FILE_GET_LAST_MODIFIED(
         return ctx->buildNil();
     }
 
-    return std::static_pointer_cast<CV::Data>(
-        ctx->buildNumber(__cv_file_filetime_to_epoch_seconds(ft))
-    );
+    return ctx->buildNumber(__cv_file_filetime_to_epoch_seconds(ft));
 }
 
 static std::shared_ptr<CV::Data> __CV_STD_FILE_GET_CREATED_AT(
@@ -949,9 +939,7 @@ static std::shared_ptr<CV::Data> __CV_STD_FILE_GET_CREATED_AT(
         return ctx->buildNil();
     }
 
-    return std::static_pointer_cast<CV::Data>(
-        ctx->buildNumber(epoch)
-    );
+    return ctx->buildNumber(epoch);
 }
 
 static std::shared_ptr<CV::Data> __CV_STD_FILE_DELETE(
@@ -978,9 +966,7 @@ static std::shared_ptr<CV::Data> __CV_STD_FILE_DELETE(
         return ctx->buildNil();
     }
 
-    return std::static_pointer_cast<CV::Data>(
-        ctx->buildNumber(removed ? 1 : 0)
-    );
+    return ctx->buildNumber(removed ? 1 : 0);
 }
 
 static std::shared_ptr<CV::Data> __CV_STD_FILE_GET_FILENAME(
@@ -996,9 +982,7 @@ static std::shared_ptr<CV::Data> __CV_STD_FILE_GET_FILENAME(
         return ctx->buildNil();
     }
 
-    return std::static_pointer_cast<CV::Data>(
-        ctx->buildString(path.filename().string())
-    );
+    return ctx->buildString(path.filename().string());
 }
 
 static std::shared_ptr<CV::Data> __CV_STD_FILE_GET_EXTENSION(
@@ -1019,9 +1003,7 @@ static std::shared_ptr<CV::Data> __CV_STD_FILE_GET_EXTENSION(
         ext.erase(0, 1);
     }
 
-    return std::static_pointer_cast<CV::Data>(
-        ctx->buildString(ext)
-    );
+    return ctx->buildString(ext);
 }
 
 extern "C" void _CV_REGISTER_LIBRARY(
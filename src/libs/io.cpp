@@ -16,7 +16,7 @@ static inline void ___GET_STDIN(std::string &v){
 }
 
 static std::shared_ptr<CV::Data> __cv_io_unwrap(const std::shared_ptr<CV::Data> &d){
-    return d ? d->unwrap() : std::shared_ptr<CV::Data>(nullptr);
+    return d ? std::shared_ptr<CV::Data>(d->unwrap()) : nullptr;
 }
 
 static bool __cv_io_expect_at_least(
@@ -178,9 +178,7 @@ static std::shared_ptr<CV::Data> __CV_STD_IO_IN(
     std::string input;
     ___GET_STDIN(input);
 
-    return std::static_pointer_cast<CV::Data>(
-        ctx->buildString(input)
-    );
+    return ctx->buildString(input);
 }
 
 extern "C" void _CV_REGISTER_LIBRARY(
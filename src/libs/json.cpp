@@ -11,15 +11,15 @@ static inline bool __cv_json_is_not_fractional(CV_NUMBER d, CV_NUMBER epsilon =
 }
 
 static std::shared_ptr<CV::Data> __cv_json_fail_num(const CV::ContextType &ctx){
-    return std::static_pointer_cast<CV::Data>(ctx->buildNumber(0));
+    return ctx->buildNumber(0);
 }
 
 static std::shared_ptr<CV::Data> __cv_json_ok_num(const CV::ContextType &ctx){
-    return std::static_pointer_cast<CV::Data>(ctx->buildNumber(1));
+    return ctx->buildNumber(1);
 }
 
 static std::shared_ptr<CV::Data> __cv_json_unwrap(const std::shared_ptr<CV::Data> &d){
-    return d ? d->unwrap() : std::shared_ptr<CV::Data>(nullptr);
+    return d ? std::shared_ptr<CV::Data>(d->unwrap()) : nullptr;
 }
 
 static bool __cv_json_expect_exactly(
@@ -152,7 +152,7 @@ static std::shared_ptr<CV::Data> __cv_json_unwrap_json(
                 list->v.push_back(child);
             }
 
-            return std::static_pointer_cast<CV::Data>(list);
+            return list;
         }
 
         case json11::Json::OBJECT: {
@@ -167,19 +167,19 @@ static std::shared_ptr<CV::Data> __cv_json_unwrap_json(
                 store->v[it.first] = child;
             }
 
-            return std::static_pointer_cast<CV::Data>(store);
+            return store;
         }
 
         case json11::Json::NUMBER: {
-            return std::static_pointer_cast<CV::Data>(ctx->buildNumber(obj.number_value()));
+            return ctx->buildNumber(obj.number_value());
         }
 
         case json11::Json::BOOL: {
-            return std::static_pointer_cast<CV::Data>(ctx->buildNumber(obj.bool_value() ? 1 : 0));
+            return ctx->buildNumber(obj.bool_value() ? 1 : 0);
         }
 
         case json11::Json::STRING: {
-            return std::static_pointer_cast<CV::Data>(ctx->buildString(obj.string_value()));
+            return ctx->buildString(obj.string_value());
         }
 
         case json11::Json::NUL: {
@@ -265,9 +265,7 @@ static std::shared_ptr<CV::Data> __CV_STD_JSON_DUMP(
         return __cv_json_fail_num(ctx);
     }
 
-    return std::static_pointer_cast<CV::Data>(
-        ctx->buildString(json11::Json(obj).dump())
-    );
+    return ctx->buildString(json11::Json(obj).dump());
 }
 
 static std::shared_ptr<CV::Data> __CV_STD_JSON_PARSE_FILE(
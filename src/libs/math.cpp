@@ -11,7 +11,7 @@ static std::mt19937 rng(std::time(nullptr));
 static std::mutex accessMutex;
 
 static std::shared_ptr<CV::Data> __cv_math_unwrap(const std::shared_ptr<CV::Data> &d){
-    return d ? d->unwrap() : std::shared_ptr<CV::Data>(nullptr);
+    return d ? std::shared_ptr<CV::Data>(d->unwrap()) : nullptr;
 }
 
 static bool __cv_math_expect_min_params(
@@ -88,15 +88,15 @@ static std::shared_ptr<CV::Data> __cv_math_variadic_number_map(
 
     if(args.size() == 1){
         auto n = std::static_pointer_cast<CV::DataNumber>(__cv_math_unwrap(args[0].second))->v;
-        return std::static_pointer_cast<CV::Data>(ctx->buildNumber(fn(n)));
+        return ctx->buildNumber(fn(n));
     }
 
     auto out = ctx->buildList();
     for(int i = 0; i < static_cast<int>(args.size()); ++i){
         auto n = std::static_pointer_cast<CV::DataNumber>(__cv_math_unwrap(args[i].second))->v;
-        out->v.push_back(std::static_pointer_cast<CV::Data>(ctx->buildNumber(fn(n))));
+        out->v.push_back(ctx->buildNumber(fn(n)));
     }
-    return std::static_pointer_cast<CV::Data>(out);
+    return out;
 }
 
 extern "C" void _CV_REGISTER_LIBRARY(
@@ -149,7 +149,7 @@ extern "C" void _CV_REGISTER_LIBRARY(
 
             auto y = std::static_pointer_cast<CV::DataNumber>(__cv_math_unwrap(args[0].second))->v;
             auto x = std::static_pointer_cast<CV::DataNumber>(__cv_math_unwrap(args[1].second))->v;
-            return std::static_pointer_cast<CV::Data>(fctx->buildNumber(std::atan2(y, x)));
+            return fctx->buildNumber(std::atan2(y, x));
         }
     );
 
@@ -220,7 +220,7 @@ extern "C" void _CV_REGISTER_LIBRARY(
 
             auto a = std::static_pointer_cast<CV::DataNumber>(__cv_math_unwrap(args[0].second))->v;
             auto b = std::static_pointer_cast<CV::DataNumber>(__cv_math_unwrap(args[1].second))->v;
-            return std::static_pointer_cast<CV::Data>(fctx->buildNumber(std::max(a, b)));
+            return fctx->buildNumber(std::max(a, b));
         }
     );
 
@@ -238,7 +238,7 @@ extern "C" void _CV_REGISTER_LIBRARY(
 
             auto a = std::static_pointer_cast<CV::DataNumber>(__cv_math_unwrap(args[0].second))->v;
             auto b = std::static_pointer_cast<CV::DataNumber>(__cv_math_unwrap(args[1].second))->v;
-            return std::static_pointer_cast<CV::Data>(fctx->buildNumber(std::min(a, b)));
+            return fctx->buildNumber(std::min(a, b));
         }
     );
 
@@ -257,7 +257,7 @@ extern "C" void _CV_REGISTER_LIBRARY(
             auto n   = std::static_pointer_cast<CV::DataNumber>(__cv_math_unwrap(args[0].second))->v;
             auto min = std::static_pointer_cast<CV::DataNumber>(__cv_math_unwrap(args[1].second))->v;
             auto max = std::static_pointer_cast<CV::DataNumber>(__cv_math_unwrap(args[2].second))->v;
-            return std::static_pointer_cast<CV::Data>(fctx->buildNumber(std::min(std::max(n, min), max)));
+            return fctx->buildNumber(std::min(std::max(n, min), max));
         }
     );
 
@@ -282,7 +282,7 @@ extern "C" void _CV_REGISTER_LIBRARY(
 
             std::lock_guard<std::mutex> lock(accessMutex);
             std::uniform_int_distribution<int> uni(a, b);
-            return std::static_pointer_cast<CV::Data>(fctx->buildNumber(uni(rng)));
+            return fctx->buildNumber(uni(rng));
         }
     );
 
@@ -310,11 +310,9 @@ extern "C" void _CV_REGISTER_LIBRARY(
                 return fctx->buildNil();
             }
 
-            return std::static_pointer_cast<CV::Data>(fctx->buildNumber(x % y));
+            return fctx->buildNumber(x % y);
         }
     );
 
-    lib->data[LIBNAME+":pi"] = std::static_pointer_cast<CV::Data>(
-        lib->buildNumber(CANVAS_STDLIB_MATH_PI)
-    );
+    lib->data[LIBNAME+":pi"] = lib->buildNumber(CANVAS_STDLIB_MATH_PI);
 }
@@ -9,7 +9,7 @@
 #include "../CV.hpp"
 
 static std::shared_ptr<CV::Data> __cv_tm_unwrap(const std::shared_ptr<CV::Data> &d){
-    return d ? d->unwrap() : std::shared_ptr<CV::Data>(nullptr);
+    return d ? std::shared_ptr<CV::Data>(d->unwrap()) : nullptr;
 }
 
 static bool __cv_tm_expect_exactly(
@@ -271,9 +271,7 @@ static std::shared_ptr<CV::Data> __CV_STD_TM_TICKS(
         now.time_since_epoch()
     ).count();
 
-    return std::static_pointer_cast<CV::Data>(
-        ctx->buildNumber(static_cast<CV_NUMBER>(ms))
-    );
+    return ctx->buildNumber(static_cast<CV_NUMBER>(ms));
 }
 
 static std::shared_ptr<CV::Data> __CV_STD_TM_EPOCH(
@@ -293,9 +291,7 @@ static std::shared_ptr<CV::Data> __CV_STD_TM_EPOCH(
         now.time_since_epoch()
     ).count();
 
-    return std::static_pointer_cast<CV::Data>(
-        ctx->buildNumber(static_cast<CV_NUMBER>(sec))
-    );
+    return ctx->buildNumber(static_cast<CV_NUMBER>(sec));
 }
 
 static std::shared_ptr<CV::Data> __CV_STD_TM_DATE(
@@ -328,9 +324,9 @@ static std::shared_ptr<CV::Data> __CV_STD_TM_DATE(
     }
 
     auto out = ctx->buildStore();
-    out->v["epoch"] = std::static_pointer_cast<CV::Data>(ctx->buildNumber(epoch));
-    out->v["tz"] = std::static_pointer_cast<CV::Data>(ctx->buildString(normalized));
-    return std::static_pointer_cast<CV::Data>(out);
+    out->v["epoch"] = ctx->buildNumber(epoch);
+    out->v["tz"] = ctx->buildString(normalized);
+    return out;
 }
 
 static std::shared_ptr<CV::Data> __CV_STD_TM_FLIP_TZ(
@@ -365,9 +361,9 @@ static std::shared_ptr<CV::Data> __CV_STD_TM_FLIP_TZ(
     }
 
     auto out = ctx->buildStore();
-    out->v["epoch"] = std::static_pointer_cast<CV::Data>(ctx->buildNumber(epoch));
-    out->v["tz"] = std::static_pointer_cast<CV::Data>(ctx->buildString(normalized));
-    return std::static_pointer_cast<CV::Data>(out);
+    out->v["epoch"] = ctx->buildNumber(epoch);
+    out->v["tz"] = ctx->buildString(normalized);
+    return out;
 }
 
 static std::shared_ptr<CV::Data> __CV_STD_TM_FORMAT(
@@ -442,9 +438,7 @@ static std::shared_ptr<CV::Data> __CV_STD_TM_FORMAT(
     __cv_tm_replace_all(fmt, "%M", __cv_tm_pad2(minute));
     __cv_tm_replace_all(fmt, "%s", __cv_tm_pad2(second));
 
-    return std::static_pointer_cast<CV::Data>(
-        ctx->buildString(fmt)
-    );
+    return ctx->buildString(fmt);
 }
 
 extern "C" void _CV_REGISTER_LIBRARY(
@@ -0,0 +1,280 @@
+#include <stdio.h>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include "../src/CV.hpp"
+
+/*
+    Tests for embedding hosts, the things Release.py can't reach from outside the process. Run by ctest.
+    Usage: cv_embedding [NAME FRAGMENT...]
+*/
+
+struct EmbeddingCase {
+	std::string name;
+	std::function<bool()> body;
+};
+
+static std::vector<std::pair<std::string, int>> engines = {{"interpreter", CV::Engine::INTERPRETER}, {"vm", CV::Engine::VM}};
+
+// Runs every statement of 'source' in 'context', null if anything failed
+static CV::Ref<CV::Data> run(const std::string &source, const CV::ContextType &context, int engine){
+	auto cursor = CV::MakeRef<CV::Cursor>();
+	auto root = CV::BuildTree(source, cursor);
+	CV::Ref<CV::Data> result;
+	for(auto &token : root){
+		if(cursor->error){
+			break;
+		}
+		auto cf = CV::MakeRef<CV::ControlFlow>();
+		cf->state = CV::ControlFlowState::CONTINUE;
+		result = engine == CV::Engine::VM ? CV::Execute(token, cursor, cf, context) : CV::Interpret(token, cursor, cf, context);
+	}
+	if(cursor->error){
+		printf("  %s\n", cursor->message.c_str());
+		return nullptr;
+	}
+	return result;
+}
+
+static bool isNumber(const CV::Ref<CV::Data> &result, CV_NUMBER v){
+	return result && result->type == CV::DataType::NUMBER && CV::CastRef<CV::DataNumber>(result)->v == v;
+}
+
+static std::vector<EmbeddingCase> buildCases(){
+	std::vector<EmbeddingCase> cases;
+
+	// Whatever a request changes in place stays in its fork, the next one starts from the same base
+	for(auto &it : engines){
+		auto engine = it.second;
+		cases.push_back({"context:fork-copy-on-write:"+it.first, [engine](){
+			auto base = CV::MakeRef<CV::Context>();
+			CV::CoreSetup(base);
+			if(!run("[let count 0] [let items [1 2 3]] [let nested [[1 2] [3 4]]]", base, engine)){
+				return false;
+			}
+			for(int i = 0; i < 2; ++i){
+				auto fork = base->fork();
+				if(!isNumber(run("[++ count] [++ count] [-- count]", fork, engine), 1) ||
+				   !isNumber(run("[>> 4 items] [>> 5 items] [<< items] [length items]", fork, engine), 4) ||
+				   !isNumber(run("[>> 5 [nth nested 0]] [length [nth nested 0]]", fork, engine), 3) ||
+				   !isNumber(run("[mut count [+ count 10]] [count]", fork, engine), 11)){
+					return false;
+				}
+			}
+			return isNumber(run("[count]", base, engine), 0) &&
+				isNumber(run("[length items]", base, engine), 3) &&
+				isNumber(run("[nth items 2]", base, engine), 3) &&
+				isNumber(run("[length [nth nested 0]]", base, engine), 2);
+		}});
+	}
+
+	/*
+		Native functions the way modules write them, handing back std::shared_ptrs of their own making and ones
+		made out of what they were given. Whatever the script keeps has to outlive the native calls
+	*/
+	for(auto &it : engines){
+		auto engine = it.second;
+		cases.push_back({"native:shared-ptr-results:"+it.first, [engine](){
+			auto context = CV::MakeRef<CV::Context>();
+			CV::CoreSetup(context);
+			context->registerFunction("made", {"v"}, CV::NativeFunction([](
+				const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
+				const CV::Ref<CV::Context> &ctx,
+				const CV::Ref<CV::Cursor> &cursor,
+				const CV::Ref<CV::Token> &token
+			) -> std::shared_ptr<CV::Data> {
+				auto n = std::make_shared<CV::DataNumber>();
+				n->v = std::static_pointer_cast<CV::DataNumber>(args[0].second)->v * 2;
+				return n;
+			}));
+			context->registerFunction("same", {"v"}, CV::NativeFunction([](
+				const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
+				const CV::Ref<CV::Context> &ctx,
+				const CV::Ref<CV::Cursor> &cursor,
+				const CV::Ref<CV::Token> &token
+			) -> std::shared_ptr<CV::Data> {
+				std::shared_ptr<CV::Data> kept = args[0].second;
+				return kept;
+			}));
+			context->registerFunction("listed", {"v"}, CV::NativeFunction([](
+				const std::vector<std::pair<std::string, std::shared_ptr<CV::Data>>> &args,
+				const CV::Ref<CV::Context> &ctx,
+				const CV::Ref<CV::Cursor> &cursor,
+				const CV::Ref<CV::Token> &token
+			) -> std::shared_ptr<CV::Data> {
+				auto list = std::make_shared<CV::DataList>();
+				list->v.push_back(std::shared_ptr<CV::Data>(std::make_shared<CV::DataNumber>()));
+				list->v.push_back(args[0].second);
+				return list;
+			}));
+			return isNumber(run(
+				"[let a [made 3]] [let b [same a]] [++ b] [let l [listed a]] [>> [made a] l] "
+				"[+ a b [length l] [nth l 2]]",
+				context, engine
+			), 7 + 7 + 3 + 14);
+		}});
+	}
+
+	// Modules bind names and fill stores by indexing them with strings, the names have to be seen right away
+	for(auto &it : engines){
+		auto engine = it.second;
+		cases.push_back({"native:string-keyed-bindings:"+it.first, [engine](){
+			auto context = CV::MakeRef<CV::Context>();
+			CV::CoreSetup(context);
+			auto store = context->buildStore();
+			store->v["a"] = context->buildNumber(3);
+			store->v["b"] = context->buildNumber(4);
+			store->v["b"] = store->v["a"];
+			context->data["lib:store"] = store;
+			context->data["lib:n"] = context->buildNumber(5);
+			std::shared_ptr<CV::Data> n = context->data["lib:n"];
+			return context->data.count("lib:n") == 1 && context->data.count("lib:missing") == 0 &&
+				!static_cast<const CV::Ref<CV::Data>&>(context->data["lib:missing"]) &&
+				isNumber(n, 5) &&
+				isNumber(run("[+ lib:n [lib:store ~a] [lib:store ~b]]", context, engine), 11);
+		}});
+	}
+
+	// Modules walk and look into stores the way they did when members were a plain map, shared ones included
+	for(auto &it : engines){
+		auto engine = it.second;
+		cases.push_back({"native:store-map-access:"+it.first, [engine](){
+			auto base = CV::MakeRef<CV::Context>();
+			CV::CoreSetup(base);
+			if(!run("[let s [[~a 1] [~b 2] [~c 3]]]", base, engine)){
+				return false;
+			}
+			CV::Share(base);
+			// The fork's copy shares its members with the base's, only '~a' is its own
+			auto made = run("[++ [s ~a]] [s]", base->fork(), engine);
+			if(!made || made->type != CV::DataType::STORE){
+				return false;
+			}
+			auto store = CV::CastRef<CV::DataStore>(made);
+			store->v["d"] = base->buildNumber(4);
+			CV_NUMBER total = 0;
+			std::size_t seen = 0;
+			for(auto &it : store->v){
+				std::shared_ptr<CV::Data> member = it.second;
+				if(member->type == CV::DataType::NUMBER){
+					total += std::static_pointer_cast<CV::DataNumber>(member)->v;
+				}
+				++seen;
+			}
+			auto a = store->v.find("a");
+			return seen == 4 && total == 11 && store->v.size() == 4 &&
+				store->v.count("a") == 1 && store->v.count("d") == 1 && store->v.count("e") == 0 &&
+				a != store->v.end() && a->first == "a" && isNumber(a->second, 2) &&
+				store->v.find("d") != store->v.end() && store->v.find("e") == store->v.end() &&
+				isNumber(run("[s ~a]", base, engine), 1) && isNumber(run("[length s]", base, engine), 3);
+		}});
+	}
+
+	/*
+		Many threads, each with contexts of its own chained to the builtins they all share, parsing and running at
+		once. Everything they built is gone once they are, in every thread's count
+	*/
+	for(auto &it : engines){
+		auto engine = it.second;
+		cases.push_back({"context:builtins-across-threads:"+it.first, [engine](){
+			CV::GetBuiltins();
+			auto live = CV::GetCollectorStats().live;
+			std::atomic<int> wrong(0);
+			std::vector<std::thread> threads;
+			for(int t = 0; t < 8; ++t){
+				threads.emplace_back([&, t](){
+					for(int i = 0; i < 200; ++i){
+						auto context = CV::MakeRef<CV::Context>();
+						CV::CoreSetup(context);
+						auto n = std::to_string(t + i);
+						auto result = run(
+							"[let l [1 2 3]] [>> "+n+" l] [let f [fn [a b] [* a b]]] [let k 0] [++ k] "
+							"[+ [f 2 3] [length l] [nth l 3] k]",
+							context, engine
+						);
+						if(!isNumber(result, 11 + t + i)){
+							++wrong;
+						}
+					}
+				});
+			}
+			for(auto &thread : threads){
+				thread.join();
+			}
+			return wrong == 0 && CV::GetCollectorStats().live == live;
+		}});
+	}
+
+	/*
+		One Program run from several threads at once against a host context they all share: every run sees the
+		host as it was set up, whatever the runs before changed in place
+	*/
+	for(auto &it : engines){
+		auto engine = it.second;
+		cases.push_back({"program:shared-across-threads:"+it.first, [engine](){
+			auto host = CV::MakeRef<CV::Context>();
+			CV::CoreSetup(host);
+			if(!run("[let counter 0] [let items [1 2 3]] [let total 0]", host, engine)){
+				return false;
+			}
+			CV::Share(host);
+			auto cursor = CV::MakeRef<CV::Cursor>();
+			auto program = CV::BuildProgram(
+				"[let sq [fn [x] [* x x]]] [++ counter] [>> n items] [mut total [+ total [sq n]]] [+ counter [length items] total]",
+				cursor, engine
+			);
+			if(!program){
+				return false;
+			}
+			std::atomic<int> wrong(0);
+			std::vector<std::thread> threads;
+			for(int t = 0; t < 4; ++t){
+				threads.emplace_back([&, t](){
+					auto cursor = CV::MakeRef<CV::Cursor>();
+					for(int i = 0; i < 500; ++i){
+						int n = (t + i) % 7;
+						auto result = program->run(host, {{"n", host->buildNumber(n)}}, cursor);
+						if(cursor->error || !isNumber(result, 5 + n * n)){
+							++wrong;
+							cursor->clear();
+						}
+					}
+				});
+			}
+			for(auto &thread : threads){
+				thread.join();
+			}
+			return wrong == 0 &&
+				isNumber(run("[counter]", host, engine), 0) &&
+				isNumber(run("[length items]", host, engine), 3) &&
+				isNumber(run("[total]", host, engine), 0);
+		}});
+	}
+
+	return cases;
+}
+
+int main(int argc, char* argv[]){
+	std::vector<std::string> only;
+	for(int i = 1; i < argc; ++i){
+		only.push_back(argv[i]);
+	}
+
+	printf("STARTING CANVAS EMBEDDING TESTS\n");
+
+	int failed = 0;
+	for(auto &c : buildCases()){
+		if(!only.empty() && std::none_of(only.begin(), only.end(), [&](const std::string &f){ return c.name.find(f) != std::string::npos; })){
+			continue;
+		}
+		bool ok = c.body();
+		if(!ok){
+			++failed;
+		}
+		printf("[%s] %s\n", c.name.c_str(), ok ? "OK" : "FAILURE");
+	}
+
+	printf("\nDONE. %d FAILURE(S)\n", failed);
+	return failed == 0 ? 0 : 1;
+}
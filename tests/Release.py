@@ -151,13 +151,28 @@ def run_subprocess(cmd, timeout: float, cwd: Optional[str] = None, env: Optional
         )
 
 
+ALLOC_RE = re.compile(r"^data allocations: (\d+)$", re.MULTILINE)
+
+
 class Runner:
-    def __init__(self, binary: str, file_flag: str):
+    def __init__(self, binary: str, file_flag: str, alloc_stats: bool = False):
         self.binary = binary
         self.file_flag = file_flag
+        # With --alloc-stats the binary reports how many Data objects it built, summed here across cases
+        self.alloc_stats = alloc_stats
+        self.allocations = 0
+
+    def command(self, *rest: str) -> list[str]:
+        return [self.binary, *(["--alloc-stats"] if self.alloc_stats else []), *rest]
+
+    def take_stats(self, result: RunResult) -> RunResult:
+        if self.alloc_stats:
+            self.allocations += sum(int(n) for n in ALLOC_RE.findall(result.stderr))
+            result.stderr = norm(ALLOC_RE.sub("", result.stderr))
+        return result
 
     def run_inline(self, command: str, timeout: float, cwd: Optional[str] = None, env: Optional[dict] = None) -> RunResult:
-        return run_subprocess([self.binary, command], timeout, cwd=cwd, env=env)
+        return run_subprocess(self.command(command), timeout, cwd=cwd, env=env)
 
     def run_file(self, source: str, timeout: float, cwd: Optional[str] = None, env: Optional[dict] = None) -> RunResult:
         with tempfile.TemporaryDirectory(prefix="canvas-file-") as td:
@@ -165,9 +180,9 @@ class Runner:
             p = Path(td) / "test.cv"
             p.write_text(source, encoding="utf-8")
             if self.file_flag:
-                cmd = [self.binary, self.file_flag, str(p)]
+                cmd = self.command(self.file_flag, str(p))
             else:
-                cmd = [self.binary, str(p)]
+                cmd = self.command(str(p))
             return run_subprocess(cmd, timeout, cwd=workdir, env=env)
 
     def run_project(self, payload: dict, timeout: float) -> RunResult:
@@ -176,7 +191,8 @@ class Runner:
             "entry_name": "main.cv",
             "files": {"main.cv": "...", "math.cv": "..."},
             "cwd_subdir": "",   # optional
-            "env": {...}        # optional
+            "env": {...},       # optional
+            "args": [...]       # optional, passed before the file
         }
         """
         with tempfile.TemporaryDirectory(prefix="canvas-proj-") as td:
@@ -195,19 +211,20 @@ class Runner:
             entry = root / payload["entry_name"]
             cwd = str(root / payload.get("cwd_subdir", "")) if payload.get("cwd_subdir") else str(root)
 
+            args = payload.get("args", [])
             if self.file_flag:
-                cmd = [self.binary, self.file_flag, str(entry)]
+                cmd = self.command(*args, self.file_flag, str(entry))
             else:
-                cmd = [self.binary, str(entry)]
+                cmd = self.command(*args, str(entry))
             return run_subprocess(cmd, timeout, cwd=cwd, env=env)
 
     def run_case(self, case: Case) -> RunResult:
         if case.mode == "inline":
-            return self.run_inline(case.payload, case.timeout)
+            return self.take_stats(self.run_inline(case.payload, case.timeout))
         if case.mode == "file":
-            return self.run_file(case.payload, case.timeout)
+            return self.take_stats(self.run_file(case.payload, case.timeout))
         if case.mode == "project":
-            return self.run_project(case.payload, case.timeout)
+            return self.take_stats(self.run_project(case.payload, case.timeout))
         return RunResult(False, None, "", "", 0.0, f"unknown mode {case.mode}")
 
 
@@ -219,11 +236,24 @@ def build_cases(binary_path: str) -> list[Case]:
         Case("literal:number", "inline", "1", exact("1"), {"core"}),
         Case("literal:string", "inline", "'hello'", exact("'hello'"), {"core"}),
         Case("literal:list", "inline", "[1 2 3]", exact("[1 2 3]"), {"core"}),
+        Case("literal:list-led-by-name", "inline", "[[let x 4] [let l [x 1]] l]", exact("[4 [4 1] [4 1]]"), {"core", "list"}),
+        Case("literal:list-led-by-names", "inline",
+             "[[let keep [b:list]] [foreach [~i [7 8 9]] [>> [i i] keep]] keep]",
+             exact("[[[7 7] [8 8] [9 9]] [[7 7] [8 8] [9 9]] [[7 7] [8 8] [9 9]]]"), {"core", "list"}),
         Case("literal:store", "inline", "[[~a 1] [~b 2]]",
              one_of(["[[~a 1] [~b 2]]", "[[~b 2] [~a 1]]"]), {"core"}),
         Case("let:basic", "inline", "[let a 5] [a]", exact("5"), {"core"}),
         Case("mut:number", "inline", "[let a 5] [mut a 7] [a]", exact("7"), {"core"}),
         Case("cc:copy-number", "inline", "[let a 5] [let b [cc a]] [mut a 9] [b]", exact("5"), {"core"}),
+        Case("cc:copy-long-list", "inline",
+             "[let l [0 0]] [for [~i [0 100]] [>> [+ i 0] l]] [let c [cc l]] [++ [nth l 40]] [>> 5 l] [<< c] [+ [nth c 40] [length c] [length l]]",
+             exact("242"), {"core", "list"}),
+        Case("cc:copy-nested-list", "inline",
+             "[let l [[1 2] [3 4]]] [for [~i [0 40]] [>> [[+ i 0] 5] l]] [let x [nth [nth l 0] 0]] [let c [cc l]] [++ x] [nth [nth c 0] 0]",
+             exact("1"), {"core", "list"}),
+        Case("cc:copy-store", "inline",
+             "[let s [[~a 1] [~b [[~x 5]]]]] [let k [s ~a]] [let c [cc s]] [++ k] [++ [c ~a]] [++ [c ~a]] [let cb [c ~b]] [++ [cb ~x]] [let sb [s ~b]] [b:list [s ~a] [c ~a] [sb ~x] [cb ~x]]",
+             exact("[2 3 5 6]"), {"core", "store"}),
     ]
 
     # Arithmetic / boolean / conditionals
@@ -264,6 +294,11 @@ def build_cases(binary_path: str) -> list[Case]:
         Case("fn:basic", "inline", "[[let add [fn [a b] [+ a b]]] [add 2 3]]", exact("5"), {"core", "fn"}),
         Case("fn:named-args", "inline", "[[let pair [fn [a b] [b:list a b]]] [pair [~b 9] [~a 3]]]",
              exact("[3 9]"), {"core", "fn"}),
+        Case("fn:named-mixed", "inline", "[[let f [fn [a b c] [b:list a b c]]] [f [~b 2] 1 3]]",
+             exact("[1 2 3]"), {"core", "fn"}),
+        Case("fn:expanded-args", "inline", "[[let f [fn [a b c] [- a b c]]] [f 10 ^[4 1]]]",
+             exact("5"), {"core", "fn"}),
+        Case("fn:extra-args", "inline", "[[let f [fn [a] [+ a arg-1]]] [f 1 2]]", exact("3"), {"core", "fn"}),
         Case("fn:variadic", "inline", "[[let id [fn [@] @]] [id 1 2 3]]", exact("[1 2 3]"), {"core", "fn"}),
         Case("typeof:number", "inline", "typeof 5", exact("'NUMBER'"), {"core", "util"}),
         Case("typeof:store", "inline", "typeof [[~a 1] [~b 2]]", exact("'STORE'"), {"core", "util"}),
@@ -350,6 +385,56 @@ def build_cases(binary_path: str) -> list[Case]:
             },
             contains("12"), {"project", "import"}
         ),
+        Case(
+            "project:import-damaged-cvc",
+            "project",
+            {
+                "entry_name": "main.cv",
+                "files": {
+                    "main.cv": "[import 'math']\n[print [double 6]]\n",
+                    "math.cv": "[let double [fn [x] [+ x x]]]\n",
+                    "math.cvc": "CVC not really a precompiled tree",
+                },
+            },
+            contains("12"), {"project", "import"}
+        ),
+        Case(
+            "project:import-twice-reruns",
+            "project",
+            {
+                "entry_name": "main.cv",
+                "files": {
+                    "main.cv": "[let n 0]\n[import 'inc']\n[import 'inc.cv']\n[print n]\n",
+                    "inc.cv": "[mut n [+ n 1]]\n",
+                },
+            },
+            exact("2"), {"project", "import"}
+        ),
+        Case(
+            "project:import-once",
+            "project",
+            {
+                "entry_name": "main.cv",
+                "files": {
+                    "main.cv": "[let n 0]\n[import 'inc']\n[import 'inc.cv']\n[print n]\n",
+                    "inc.cv": "[mut n [+ n 1]]\n",
+                },
+                "args": ["--import-once"],
+            },
+            exact("1"), {"project", "import"}
+        ),
+        Case(
+            "project:collect-cycles",
+            "project",
+            {
+                "entry_name": "main.cv",
+                "files": {
+                    "main.cv": "[let cycle [fn [x] [length [>> [let l [x 2]] l]]]]\n[for [~i [0 200]] [cycle i]]\n[print 'done']\n",
+                },
+                "args": ["--gc-stats", "--gc-threshold", "1"],
+            },
+            contains("200 collected", exit_code=0), {"project", "collector"}
+        ),
     ]
 
     # Error cases
@@ -357,10 +442,13 @@ def build_cases(binary_path: str) -> list[Case]:
         Case("error:undefined-name", "inline", "does_not_exist", contains("Undefined imperative", exit_code=1), {"error"}),
         Case("error:bad-nth", "inline", "nth [1 2 3] 9", contains("Invalid Index", exit_code=1), {"error"}),
         Case("error:bad-let-name", "inline", "[let 123 5]", contains("Misused Constructor", exit_code=1), {"error"}),
+        Case("error:namer-reserved", "inline", "[b:store [~let 5]]", contains("native constructor", exit_code=1), {"error"}),
         Case("error:bad-for", "inline", "[for [0 5] [print 1]]", contains("Illegal Iterator", exit_code=1), {"error"}),
         Case("error:bad-foreach", "inline", "[foreach [~x 5] [print x]]", contains("Illegal Iterator", exit_code=1), {"error"}),
         Case("error:div-zero", "inline", "/ 10 0", contains("Division by zero", exit_code=1), {"error"}),
         Case("error:mismatching-brackets", "inline", "[[let a 1]", contains("Syntax Error", exit_code=1), {"error"}),
+        Case("error:try-in-loop", "inline", "[[let l [1 2 3]] [let s 0] [for [~i [0 5]] ?[mut s [+ s [nth l i] 10]]] s]",
+             exact("[[1 2 3] 36 nil 36]"), {"error", "loop"}),
     ]
 
     # Soak-ish repeats
@@ -390,6 +478,11 @@ def build_cases(binary_path: str) -> list[Case]:
                      "[[~ok 1] [~b [2 3]] [~a 1]]",
                  ]),
                  {"dynlib", "json"}),
+            # The second import binds the library's table into a fresh context without registering it again
+            Case("dynlib:json-per-call", "inline",
+                 "[let f [fn [x] [[import 'json'] [json:dump x]]]] [f [1 2]] [f [3 4]]",
+                 exact("[1 '[3, 4]']"),
+                 {"dynlib", "json"}),
         ]
 
     return cases
@@ -421,6 +514,7 @@ def main():
     ap.add_argument("--repeats", type=int, default=1, help="Multiply repeat counts")
     ap.add_argument("--tags", nargs="*", default=[], help="Run only cases matching any of these tags")
     ap.add_argument("--only", nargs="*", default=[], help="Run only cases whose names contain one of these fragments")
+    ap.add_argument("--alloc-stats", action="store_true", help="Report the Data objects allocated across all cases")
     args = ap.parse_args()
 
     file_flag = args.file_flag
@@ -430,7 +524,7 @@ def main():
     from pathlib import Path
 
     binary_path = str(Path(args.bin).resolve())
-    runner = Runner(binary_path, file_flag)
+    runner = Runner(binary_path, file_flag, args.alloc_stats)
     cases = build_cases(binary_path)
 
     if args.tags:
@@ -476,6 +570,8 @@ def main():
 
     elapsed = time.time() - started
     print(f"\nDONE. SUCCEEDED {total - failed} | FAILED {failed} | TOTAL {total} | TIME {elapsed:.2f}s")
+    if args.alloc_stats:
+        print(f"DATA ALLOCATIONS {runner.allocations}")
     if failed == 0:
         print("\n<---------------------ALL TESTS PASSED--------------------->")
         return 0